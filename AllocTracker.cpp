@@ -0,0 +1,188 @@
+/**
+ * @file AllocTracker.cpp
+ * @brief This file contains the implementation of the AllocTracker class and the replacement global
+ * operator new and operator delete that feed it.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "AllocTracker.hpp"
+#include <cstdlib> // For std::malloc, std::aligned_alloc, std::free
+#include <iomanip> // For std::setw
+#include <new>
+
+// Counts of the calling thread; constant-initialized, so access needs no guard
+struct ThreadAllocs {
+    AllocStats total;
+    const char* names[AllocTracker::MAX_SCOPES] = {};
+    AllocStats scopes[AllocTracker::MAX_SCOPES];
+    int scope_count = 0;
+    int current = -1;
+};
+
+static thread_local ThreadAllocs thread_allocs;
+
+static inline void countAllocation(std::size_t size) {
+    ThreadAllocs& allocs = thread_allocs;
+    allocs.total.allocations++;
+    allocs.total.bytes += size;
+    if (allocs.current >= 0) {
+        allocs.scopes[allocs.current].allocations++;
+        allocs.scopes[allocs.current].bytes += size;
+    }
+}
+
+static inline void countFree(void* pointer) {
+    if (pointer == nullptr) {
+        return;
+    }
+    ThreadAllocs& allocs = thread_allocs;
+    allocs.total.frees++;
+    if (allocs.current >= 0) {
+        allocs.scopes[allocs.current].frees++;
+    }
+}
+
+static void* allocate(std::size_t size) {
+    countAllocation(size);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+static void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    countAllocation(size);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    // aligned_alloc requires the size to be a multiple of the alignment
+    std::size_t rounded = (size + align - 1) / align * align;
+    return std::aligned_alloc(align, rounded == 0 ? align : rounded);
+}
+
+static void release(void* pointer) {
+    countFree(pointer);
+    std::free(pointer);
+}
+
+// ********* GLOBAL OPERATOR NEW AND DELETE **************//
+
+void* operator new(std::size_t size) {
+    void* pointer = allocate(size);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* pointer = allocateAligned(size, alignment);
+    if (pointer == nullptr) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return allocateAligned(size, alignment);
+}
+
+void operator delete(void* pointer) noexcept { release(pointer); }
+void operator delete[](void* pointer) noexcept { release(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { release(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { release(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { release(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { release(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { release(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { release(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { release(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { release(pointer); }
+
+// ********* ALLOC TRACKER **************//
+
+/**
+ * Attributes the allocations made by the calling thread while it is alive to `name`.
+ */
+AllocTracker::Scope::Scope(const char* name) : previous_(thread_allocs.current) {
+    ThreadAllocs& allocs = thread_allocs;
+    int index = 0;
+    while (index < allocs.scope_count && allocs.names[index] != name) {
+        index++;
+    }
+    if (index == allocs.scope_count) {
+        if (allocs.scope_count == MAX_SCOPES) {
+            index = previous_; // Table full: keep attributing to the enclosing scope
+        } else {
+            allocs.names[allocs.scope_count++] = name;
+        }
+    }
+    allocs.current = index;
+}
+
+AllocTracker::Scope::~Scope() {
+    thread_allocs.current = previous_;
+}
+
+/**
+ * @return The allocation counts of the calling thread since it started.
+ */
+AllocStats AllocTracker::threadStats() {
+    return thread_allocs.total;
+}
+
+/**
+ * @return The allocation counts the calling thread made inside scopes named `name`.
+ */
+AllocStats AllocTracker::scopeStats(const char* name) {
+    const ThreadAllocs& allocs = thread_allocs;
+    for (int i = 0; i < allocs.scope_count; i++) {
+        if (allocs.names[i] == name) {
+            return allocs.scopes[i];
+        }
+    }
+    return AllocStats();
+}
+
+/**
+ * @post Clears the per-scope counts of the calling thread.
+ */
+void AllocTracker::resetScopes() {
+    ThreadAllocs& allocs = thread_allocs;
+    for (int i = 0; i < allocs.scope_count; i++) {
+        allocs.scopes[i] = AllocStats();
+    }
+}
+
+/**
+ * @post Outputs allocations, bytes and frees per scope of the calling thread, one line each.
+ */
+void AllocTracker::writeScopes(std::ostream& out) {
+    // Copy first: writing to the stream may itself allocate
+    ThreadAllocs allocs = thread_allocs;
+    out << std::left << std::setw(32) << "scope" << std::right << std::setw(14) << "allocations"
+        << std::setw(14) << "bytes" << std::setw(14) << "frees" << '\n';
+    for (int i = 0; i < allocs.scope_count; i++) {
+        out << std::left << std::setw(32) << allocs.names[i] << std::right << std::setw(14)
+            << allocs.scopes[i].allocations << std::setw(14) << allocs.scopes[i].bytes << std::setw(14)
+            << allocs.scopes[i].frees << '\n';
+    }
+}
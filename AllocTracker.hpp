@@ -0,0 +1,95 @@
+/**
+ * @file AllocTracker.hpp
+ * @brief This file contains the declaration of the AllocTracker class, which counts heap allocations
+ * by replacing the global operator new and operator delete.
+ *
+ * Linking AllocTracker.o into a program installs the replacements. Every allocation and free is
+ * counted for the calling thread and attributed to the innermost AllocTracker::Scope open on that
+ * thread (for example the Kitchen operation being executed). Counting uses plain thread-local
+ * integers, so it adds no contention of its own.
+ *
+ * Kitchen opens an ALLOC_SCOPE in each of its traced functions. ALLOC_SCOPE compiles to a Scope
+ * only when the program is compiled with -DKITCHEN_TRACK_ALLOCS (`make TRACK_ALLOCS=1`, which also
+ * links AllocTracker.o into every program); otherwise it expands to nothing.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef ALLOC_TRACKER_HPP
+#define ALLOC_TRACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#define ALLOC_CONCAT_INNER(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT_INNER(a, b)
+
+// Attributes the allocations of the rest of the enclosing scope to `name`, a string literal, when
+// allocation tracking is compiled in
+#ifdef KITCHEN_TRACK_ALLOCS
+#define ALLOC_SCOPE(name) AllocTracker::Scope ALLOC_CONCAT(alloc_scope_, __LINE__)(name)
+#else
+#define ALLOC_SCOPE(name) ((void)0)
+#endif
+
+/**
+ * Allocation counts of one thread (or one scope of one thread).
+ */
+struct AllocStats {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+    uint64_t frees = 0;
+
+    /**
+     * @param earlier Stats taken before these.
+     * @return The counts accumulated between the two.
+     */
+    AllocStats operator-(const AllocStats& earlier) const {
+        return {allocations - earlier.allocations, bytes - earlier.bytes, frees - earlier.frees};
+    }
+};
+
+class AllocTracker {
+public:
+    static const int MAX_SCOPES = 32; // Distinct scope names tracked per thread
+
+    /**
+     * Attributes the allocations made by the calling thread while it is alive to `name`.
+     * `name` must be a string literal (scopes are identified by address).
+     */
+    class Scope {
+    public:
+        explicit Scope(const char* name);
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        int previous_;
+    };
+
+    /**
+     * @return The allocation counts of the calling thread since it started.
+     */
+    static AllocStats threadStats();
+
+    /**
+     * @param name The name given to AllocTracker::Scope.
+     * @return The allocation counts the calling thread made inside scopes named `name`.
+     */
+    static AllocStats scopeStats(const char* name);
+
+    /**
+     * @post Clears the per-scope counts of the calling thread.
+     */
+    static void resetScopes();
+
+    /**
+     * @post Outputs allocations, bytes and frees per scope of the calling thread, one line each.
+     */
+    static void writeScopes(std::ostream& out);
+};
+
+#endif // ALLOC_TRACKER_HPP
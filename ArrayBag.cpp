@@ -6,6 +6,8 @@ DO NOT MODIFY THIS FILE. YOU DO NOT HAVE TO SUBMIT THIS FILE
 
 
 #include "ArrayBag.hpp"
+#include "Instrumentation.hpp"
+#include <utility> // For std::swap
 
 /** default constructor**/
 template<class ItemType>
@@ -62,7 +64,13 @@ bool ArrayBag<ItemType>::remove(const ItemType& an_entry)
 	if (can_remove)
 	{
 		item_count_--;
-		items_[found_index] = items_[item_count_];
+		// Swap rather than copy: the removed entry keeps its storage in the now-unused slot,
+		// so a later add() can reuse it instead of allocating
+		if (found_index != item_count_)
+		{
+			std::swap(items_[found_index], items_[item_count_]);
+			INSTRUMENT_COUNT(elements_shifted);
+		}
 	}  // end if
 
 	return can_remove;
@@ -107,6 +115,42 @@ bool ArrayBag<ItemType>::contains(const ItemType& an_entry) const
 	return getIndexOf(an_entry) > -1;
 }  // end contains
 
+/**
+ @return a pointer to the first of the getCurrentSize() items
+ **/
+template<class ItemType>
+const ItemType* ArrayBag<ItemType>::data() const
+{
+	return items_;
+}  // end data
+
+/**
+ @return an iterator to the first item
+ **/
+template<class ItemType>
+const ItemType* ArrayBag<ItemType>::begin() const
+{
+	return items_;
+}  // end begin
+
+/**
+ @return an iterator just past the last item
+ **/
+template<class ItemType>
+const ItemType* ArrayBag<ItemType>::end() const
+{
+	return items_ + item_count_;
+}  // end end
+
+/**
+ @return item_count_, as an unsigned size for the standard library
+ **/
+template<class ItemType>
+std::size_t ArrayBag<ItemType>::size() const
+{
+	return static_cast<std::size_t>(item_count_);
+}  // end size
+
 // ********* PRIVATE METHODS **************//
 
 /**
@@ -123,7 +167,7 @@ int ArrayBag<ItemType>::getIndexOf(const ItemType& target) const
    // If the bag is empty, item_count_ is zero, so loop is skipped
    while (!found && (search_index < item_count_))
    {
-
+      INSTRUMENT_COUNT(slots_scanned);
       if (items_[search_index] == target)
       {
          found = true;
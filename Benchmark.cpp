@@ -0,0 +1,444 @@
+/**
+ * @file Benchmark.cpp
+ * @brief This file contains the implementation of the BenchmarkRunner class, a small self-contained
+ * micro-benchmark harness used to measure ArrayBag, Dish and Kitchen.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Benchmark.hpp"
+#include <algorithm> // For std::sort
+#include <chrono>    // For std::chrono::steady_clock
+#include <cctype>    // For std::isspace
+#include <cmath>     // For std::sqrt
+#include <cstdlib>   // For std::strtod
+#include <cstring>   // For std::strlen
+#include <iomanip>   // For std::setw and std::setprecision
+#include <iterator>  // For std::istreambuf_iterator
+
+/**
+ * @param options The sampling options shared by every benchmark.
+ */
+BenchmarkRunner::BenchmarkRunner(const Options& options) : options_(options) {
+}
+
+/**
+ * @param probe A probe to run with every benchmark. The runner does not take ownership.
+ */
+void BenchmarkRunner::addProbe(BenchmarkProbe* probe) {
+    probes_.push_back(probe);
+}
+
+/**
+ * @post The property is written to the "context" object of the JSON output.
+ */
+void BenchmarkRunner::addContext(const std::string& key, const std::string& value) {
+    context_.push_back({key, value});
+}
+
+/**
+ * @param name The name of the benchmark.
+ * @return True if the name passes the filter given in the options.
+ */
+bool BenchmarkRunner::enabled(const std::string& name) const {
+    return options_.filter.empty() || name.find(options_.filter) != std::string::npos;
+}
+
+/**
+ * Runs one benchmark.
+ * @post Appends a BenchmarkResult to the results, unless the name is filtered out.
+ */
+void BenchmarkRunner::run(const std::string& name, int size, long long ops_per_batch,
+                          const std::function<void()>& setup, const std::function<void()>& body) {
+    if (!enabled(name)) {
+        return;
+    }
+
+    // Calibrate: double the number of batches until one sample lasts at least min_sample_ms
+    const double min_sample_ns = options_.min_sample_ms * 1e6;
+    long long batches = 1;
+    while (timeBatches(batches, setup, body) < min_sample_ns && batches < (1LL << 30)) {
+        batches *= 2;
+    }
+
+    for (int i = 0; i < options_.warmup_samples; i++) {
+        timeBatches(batches, setup, body);
+    }
+
+    BenchmarkResult result;
+    result.name = name;
+    result.size = size;
+    result.ops_per_sample = batches * ops_per_batch;
+    for (int i = 0; i < options_.repetitions; i++) {
+        double elapsed_ns = timeBatches(batches, setup, body);
+        result.samples.push_back(elapsed_ns / result.ops_per_sample);
+    }
+    result.stats = summarize(result.samples);
+
+    // Untimed probe pass over one sample's worth of batches
+    if (!probes_.empty()) {
+        for (long long i = 0; i < batches; i++) {
+            if (setup) {
+                setup();
+            }
+            for (BenchmarkProbe* probe : probes_) {
+                probe->start();
+            }
+            body();
+            for (auto it = probes_.rbegin(); it != probes_.rend(); ++it) {
+                (*it)->stop();
+            }
+        }
+        for (BenchmarkProbe* probe : probes_) {
+            probe->report(result.counters, result.ops_per_sample);
+        }
+    }
+    results_.push_back(result);
+}
+
+/**
+ * @return All results recorded so far, in the order the benchmarks ran.
+ */
+const std::vector<BenchmarkResult>& BenchmarkRunner::results() const {
+    return results_;
+}
+
+/**
+ * @post Outputs one line per result with its summary statistics.
+ */
+void BenchmarkRunner::printSummary(std::ostream& out) const {
+    out << std::left << std::setw(48) << "benchmark" << std::right << std::setw(9) << "size"
+        << std::setw(12) << "min ns" << std::setw(12) << "median ns" << std::setw(12) << "mean ns"
+        << std::setw(10) << "stddev" << '\n';
+    out << std::fixed << std::setprecision(2);
+    for (const BenchmarkResult& result : results_) {
+        out << std::left << std::setw(48) << result.name << std::right << std::setw(9) << result.size
+            << std::setw(12) << result.stats.min << std::setw(12) << result.stats.median
+            << std::setw(12) << result.stats.mean << std::setw(10) << result.stats.stddev << '\n';
+    }
+}
+
+// Writes a string as a JSON string literal
+static void writeJsonString(std::ostream& out, const std::string& text) {
+    out << '"';
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c)
+                << std::dec << std::setfill(' ');
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+/**
+ * @post Outputs every result, including the raw samples, as a JSON document.
+ */
+void BenchmarkRunner::writeJson(std::ostream& out) const {
+    out << std::setprecision(6) << std::defaultfloat;
+    out << "{\n  \"context\": {\"warmup_samples\": " << options_.warmup_samples
+        << ", \"repetitions\": " << options_.repetitions
+        << ", \"min_sample_ms\": " << options_.min_sample_ms;
+    for (const auto& property : context_) {
+        out << ", ";
+        writeJsonString(out, property.first);
+        out << ": ";
+        writeJsonString(out, property.second);
+    }
+    out << "},\n";
+    out << "  \"benchmarks\": [";
+    for (size_t i = 0; i < results_.size(); i++) {
+        const BenchmarkResult& result = results_[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"name\": ";
+        writeJsonString(out, result.name);
+        out << ", \"size\": " << result.size << ", \"ops_per_sample\": " << result.ops_per_sample
+            << ",\n     \"min_ns\": " << result.stats.min << ", \"median_ns\": " << result.stats.median
+            << ", \"mean_ns\": " << result.stats.mean << ", \"stddev_ns\": " << result.stats.stddev
+            << ", \"max_ns\": " << result.stats.max;
+        for (const auto& counter : result.counters) {
+            out << ", ";
+            writeJsonString(out, counter.first);
+            out << ": " << counter.second;
+        }
+        out << ",\n     \"samples_ns\": [";
+        for (size_t j = 0; j < result.samples.size(); j++) {
+            out << (j == 0 ? "" : ", ") << result.samples[j];
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+// Minimal reader for the JSON documents writeJson produces (objects, arrays, strings, numbers, literals)
+class JsonCursor {
+public:
+    explicit JsonCursor(const std::string& text) : text_(text), pos_(0) {}
+
+    // Consumes `c` (after whitespace) if it is the next character
+    bool accept(char c) {
+        skipWhitespace();
+        if (pos_ < text_.size() && text_[pos_] == c) {
+            pos_++;
+            return true;
+        }
+        return false;
+    }
+
+    bool peekIs(char c) {
+        skipWhitespace();
+        return pos_ < text_.size() && text_[pos_] == c;
+    }
+
+    bool readString(std::string& value) {
+        value.clear();
+        if (!accept('"')) {
+            return false;
+        }
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char c = text_[pos_++];
+            if (c == '\\' && pos_ < text_.size()) {
+                c = text_[pos_++];
+                if (c == 'u') {
+                    // Only the control characters writeJson escapes are expected here
+                    if (pos_ + 4 > text_.size()) {
+                        return false;
+                    }
+                    c = static_cast<char>(std::stoi(text_.substr(pos_, 4), nullptr, 16));
+                    pos_ += 4;
+                } else if (c == 'n') {
+                    c = '\n';
+                } else if (c == 't') {
+                    c = '\t';
+                }
+            }
+            value += c;
+        }
+        return accept('"');
+    }
+
+    bool readNumber(double& value) {
+        skipWhitespace();
+        const char* start = text_.c_str() + pos_;
+        char* end = nullptr;
+        value = std::strtod(start, &end);
+        if (end == start) {
+            return false;
+        }
+        pos_ += end - start;
+        return true;
+    }
+
+    // Skips one value of any type
+    bool skipValue() {
+        skipWhitespace();
+        if (pos_ >= text_.size()) {
+            return false;
+        }
+        char c = text_[pos_];
+        std::string text;
+        double number;
+        if (c == '"') {
+            return readString(text);
+        }
+        if (c == '{' || c == '[') {
+            char close = c == '{' ? '}' : ']';
+            pos_++;
+            if (accept(close)) {
+                return true;
+            }
+            do {
+                if (c == '{' && (!readString(text) || !accept(':'))) {
+                    return false;
+                }
+                if (!skipValue()) {
+                    return false;
+                }
+            } while (accept(','));
+            return accept(close);
+        }
+        for (const char* literal : {"true", "false", "null"}) {
+            if (text_.compare(pos_, std::strlen(literal), literal) == 0) {
+                pos_ += std::strlen(literal);
+                return true;
+            }
+        }
+        return readNumber(number);
+    }
+
+private:
+    const std::string& text_;
+    size_t pos_;
+
+    void skipWhitespace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            pos_++;
+        }
+    }
+};
+
+// Reads one entry of the "benchmarks" array
+static bool readResult(JsonCursor& json, BenchmarkResult& result) {
+    if (!json.accept('{')) {
+        return false;
+    }
+    if (json.accept('}')) {
+        return true;
+    }
+    do {
+        std::string key;
+        if (!json.readString(key) || !json.accept(':')) {
+            return false;
+        }
+        double number = 0;
+        if (key == "name") {
+            if (!json.readString(result.name)) {
+                return false;
+            }
+        } else if (key == "samples_ns") {
+            if (!json.accept('[')) {
+                return false;
+            }
+            if (!json.accept(']')) {
+                do {
+                    if (!json.readNumber(number)) {
+                        return false;
+                    }
+                    result.samples.push_back(number);
+                } while (json.accept(','));
+                if (!json.accept(']')) {
+                    return false;
+                }
+            }
+        } else if (json.peekIs('"') || json.peekIs('{') || json.peekIs('[')) {
+            if (!json.skipValue()) {
+                return false;
+            }
+        } else {
+            if (!json.readNumber(number)) {
+                return false;
+            }
+            if (key == "size") {
+                result.size = static_cast<int>(number);
+            } else if (key == "ops_per_sample") {
+                result.ops_per_sample = static_cast<long long>(number);
+            } else if (key == "min_ns") {
+                result.stats.min = number;
+            } else if (key == "median_ns") {
+                result.stats.median = number;
+            } else if (key == "mean_ns") {
+                result.stats.mean = number;
+            } else if (key == "stddev_ns") {
+                result.stats.stddev = number;
+            } else if (key == "max_ns") {
+                result.stats.max = number;
+            } else {
+                result.counters.emplace_back(key, number);
+            }
+        }
+    } while (json.accept(','));
+    return json.accept('}');
+}
+
+/**
+ * @param in A JSON document written by writeJson.
+ * @param results Receives the benchmarks of the document, with their samples and counters.
+ * @return True if the document could be parsed, false otherwise.
+ */
+bool BenchmarkRunner::readJson(std::istream& in, std::vector<BenchmarkResult>& results) {
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    JsonCursor json(text);
+    results.clear();
+    if (!json.accept('{')) {
+        return false;
+    }
+    if (json.accept('}')) {
+        return true;
+    }
+    do {
+        std::string key;
+        if (!json.readString(key) || !json.accept(':')) {
+            return false;
+        }
+        if (key != "benchmarks") {
+            if (!json.skipValue()) {
+                return false;
+            }
+            continue;
+        }
+        if (!json.accept('[')) {
+            return false;
+        }
+        if (json.accept(']')) {
+            continue;
+        }
+        do {
+            BenchmarkResult result;
+            if (!readResult(json, result)) {
+                return false;
+            }
+            results.push_back(result);
+        } while (json.accept(','));
+        if (!json.accept(']')) {
+            return false;
+        }
+    } while (json.accept(','));
+    return json.accept('}');
+}
+
+/**
+ * @param samples A list of measurements.
+ * @return The summary statistics of the measurements.
+ */
+BenchmarkStats BenchmarkRunner::summarize(std::vector<double> samples) {
+    BenchmarkStats stats;
+    if (samples.empty()) {
+        return stats;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    size_t count = samples.size();
+    stats.min = samples.front();
+    stats.max = samples.back();
+    stats.median = (count % 2 == 1) ? samples[count / 2]
+                                    : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+
+    double sum = 0;
+    for (double sample : samples) {
+        sum += sample;
+    }
+    stats.mean = sum / count;
+
+    double squares = 0;
+    for (double sample : samples) {
+        squares += (sample - stats.mean) * (sample - stats.mean);
+    }
+    stats.stddev = count > 1 ? std::sqrt(squares / (count - 1)) : 0;
+    return stats;
+}
+
+// Runs `batches` setup/body pairs and returns the total time spent in `body`, in nanoseconds
+double BenchmarkRunner::timeBatches(long long batches, const std::function<void()>& setup,
+                                    const std::function<void()>& body) const {
+    using Clock = std::chrono::steady_clock;
+    Clock::duration total = Clock::duration::zero();
+    if (!setup) {
+        // Nothing to exclude, so time all batches in one interval
+        Clock::time_point start = Clock::now();
+        for (long long i = 0; i < batches; i++) {
+            body();
+        }
+        total = Clock::now() - start;
+    } else {
+        for (long long i = 0; i < batches; i++) {
+            setup();
+            Clock::time_point start = Clock::now();
+            body();
+            total += Clock::now() - start;
+        }
+    }
+    return std::chrono::duration<double, std::nano>(total).count();
+}
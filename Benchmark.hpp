@@ -0,0 +1,169 @@
+/**
+ * @file Benchmark.hpp
+ * @brief This file contains the declaration of the BenchmarkRunner class, a small self-contained
+ * micro-benchmark harness used to measure ArrayBag, Dish and Kitchen.
+ *
+ * A benchmark is a timed body that performs a known number of operations, optionally preceded by an
+ * untimed setup step. The runner calibrates how many batches make up one sample, performs warmup
+ * samples, records a series of measured samples and summarizes them (min, median, mean, standard
+ * deviation, max). Results can be printed as a table or written as JSON.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP
+
+#include <functional>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Prevents the compiler from optimizing away a value computed inside a benchmark body.
+ * @param value The value that must be considered "used".
+ */
+template <class T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * Summary statistics over the samples of one benchmark, in nanoseconds per operation.
+ */
+struct BenchmarkStats {
+    double min = 0;
+    double median = 0;
+    double mean = 0;
+    double stddev = 0;
+    double max = 0;
+};
+
+/**
+ * The measurements of one benchmark at one size.
+ */
+struct BenchmarkResult {
+    std::string name;                  // e.g. "Kitchen::newOrder"
+    int size = 0;                      // Number of items in the container under test
+    long long ops_per_sample = 0;      // Operations timed in every sample
+    std::vector<double> samples;       // Nanoseconds per operation, one entry per sample
+    BenchmarkStats stats;
+    std::vector<std::pair<std::string, double>> counters; // Extra per-operation metrics
+};
+
+/**
+ * An extra measurement (operation counters, hardware counters, ...) attached to every benchmark.
+ * Probes run in a separate pass after the timed samples, so their own cost never shows up in the
+ * timings; within that pass they bracket only the body, never the setup.
+ */
+class BenchmarkProbe {
+public:
+    virtual ~BenchmarkProbe() = default;
+
+    /**
+     * @post Starts (or resumes) measuring. Called right before every call of the body.
+     */
+    virtual void start() = 0;
+
+    /**
+     * @post Stops measuring. Called right after every call of the body.
+     */
+    virtual void stop() = 0;
+
+    /**
+     * @param counters Receives the named measurements.
+     * @param ops The number of operations performed while the probe was measuring.
+     * @post Appends the measurements, per operation, to `counters` and resets the probe.
+     */
+    virtual void report(std::vector<std::pair<std::string, double>>& counters, long long ops) = 0;
+};
+
+class BenchmarkRunner {
+public:
+    /**
+     * Options controlling how every benchmark is sampled.
+     */
+    struct Options {
+        int warmup_samples = 2;      // Samples run and discarded before measuring
+        int repetitions = 15;        // Measured samples per benchmark
+        double min_sample_ms = 2.0;  // Minimum timed duration of one sample
+        std::string filter;          // Only run benchmarks whose name contains this string
+    };
+
+    /**
+     * @param options The sampling options shared by every benchmark.
+     */
+    explicit BenchmarkRunner(const Options& options);
+
+    /**
+     * @param probe A probe to run with every benchmark. The runner does not take ownership.
+     */
+    void addProbe(BenchmarkProbe* probe);
+
+    /**
+     * @param key The name of a property of the run (e.g. "perf_counters").
+     * @param value The value of the property.
+     * @post The property is written to the "context" object of the JSON output.
+     */
+    void addContext(const std::string& key, const std::string& value);
+
+    /**
+     * @param name The name of the benchmark.
+     * @return True if the name passes the filter given in the options.
+     */
+    bool enabled(const std::string& name) const;
+
+    /**
+     * Runs one benchmark.
+     * @param name The name of the benchmark.
+     * @param size The number of items in the container under test.
+     * @param ops_per_batch The number of operations performed by one call of `body`.
+     * @param setup Untimed step run before every call of `body` (may be empty).
+     * @param body Timed step performing `ops_per_batch` operations.
+     * @post Appends a BenchmarkResult to the results, unless the name is filtered out.
+     */
+    void run(const std::string& name, int size, long long ops_per_batch,
+             const std::function<void()>& setup, const std::function<void()>& body);
+
+    /**
+     * @return All results recorded so far, in the order the benchmarks ran.
+     */
+    const std::vector<BenchmarkResult>& results() const;
+
+    /**
+     * @post Outputs one line per result with its summary statistics.
+     */
+    void printSummary(std::ostream& out) const;
+
+    /**
+     * @post Outputs every result, including the raw samples, as a JSON document.
+     */
+    void writeJson(std::ostream& out) const;
+
+    /**
+     * @param in A JSON document written by writeJson.
+     * @param results Receives the benchmarks of the document, with their samples and counters.
+     * @return True if the document could be parsed, false otherwise.
+     */
+    static bool readJson(std::istream& in, std::vector<BenchmarkResult>& results);
+
+    /**
+     * @param samples A list of measurements.
+     * @return The summary statistics of the measurements.
+     */
+    static BenchmarkStats summarize(std::vector<double> samples);
+
+private:
+    Options options_;
+    std::vector<BenchmarkResult> results_;
+    std::vector<BenchmarkProbe*> probes_;
+    std::vector<std::pair<std::string, std::string>> context_;
+
+    // Runs `batches` setup/body pairs and returns the total time spent in `body`, in nanoseconds
+    double timeBatches(long long batches, const std::function<void()>& setup,
+                       const std::function<void()>& body) const;
+};
+
+#endif // BENCHMARK_HPP
@@ -0,0 +1,164 @@
+/**
+ * @file BenchmarkCompare.cpp
+ * @brief This file contains the implementation of the BenchmarkComparer class, which compares benchmark
+ * results against a stored baseline and flags statistically significant slowdowns.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "BenchmarkCompare.hpp"
+#include <algorithm> // For std::sort
+#include <cmath>     // For std::sqrt, std::erfc, std::fabs
+#include <iomanip>   // For std::setw and std::setprecision
+
+/**
+ * @param options The thresholds applied to every benchmark.
+ */
+BenchmarkComparer::BenchmarkComparer(const Options& options) : options_(options) {
+}
+
+/**
+ * @return One comparison per benchmark of either run.
+ */
+std::vector<BenchmarkComparison> BenchmarkComparer::compare(const std::vector<BenchmarkResult>& baseline,
+                                                            const std::vector<BenchmarkResult>& current) const {
+    std::vector<BenchmarkComparison> comparisons;
+    std::vector<bool> matched(baseline.size(), false);
+
+    for (const BenchmarkResult& result : current) {
+        BenchmarkComparison comparison;
+        comparison.name = result.name;
+        comparison.size = result.size;
+        comparison.current_median = result.stats.median;
+        comparison.status = BenchmarkComparison::ADDED;
+
+        for (size_t i = 0; i < baseline.size(); i++) {
+            if (matched[i] || baseline[i].name != result.name || baseline[i].size != result.size) {
+                continue;
+            }
+            matched[i] = true;
+            comparison.baseline_median = baseline[i].stats.median;
+            comparison.change = comparison.baseline_median > 0
+                                    ? comparison.current_median / comparison.baseline_median - 1 : 0;
+            comparison.p_value = mannWhitney(baseline[i].samples, result.samples).p_value;
+
+            bool significant = comparison.p_value < options_.alpha;
+            if (significant && comparison.change > options_.threshold) {
+                comparison.status = BenchmarkComparison::REGRESSION;
+            } else if (significant && comparison.change < -options_.threshold) {
+                comparison.status = BenchmarkComparison::IMPROVEMENT;
+            } else {
+                comparison.status = BenchmarkComparison::UNCHANGED;
+            }
+            break;
+        }
+        comparisons.push_back(comparison);
+    }
+
+    for (size_t i = 0; i < baseline.size(); i++) {
+        if (!matched[i]) {
+            BenchmarkComparison comparison;
+            comparison.name = baseline[i].name;
+            comparison.size = baseline[i].size;
+            comparison.baseline_median = baseline[i].stats.median;
+            comparison.status = BenchmarkComparison::REMOVED;
+            comparisons.push_back(comparison);
+        }
+    }
+    return comparisons;
+}
+
+/**
+ * @post Outputs one line per comparison, followed by the number of regressions.
+ */
+void BenchmarkComparer::printReport(const std::vector<BenchmarkComparison>& comparisons, std::ostream& out) {
+    int regressions = 0;
+    int improvements = 0;
+    out << std::left << std::setw(44) << "benchmark" << std::right << std::setw(9) << "size"
+        << std::setw(14) << "base ns/op" << std::setw(14) << "new ns/op" << std::setw(10) << "change"
+        << std::setw(10) << "p" << "  status" << '\n';
+    for (const BenchmarkComparison& comparison : comparisons) {
+        out << std::left << std::setw(44) << comparison.name << std::right << std::setw(9) << comparison.size
+            << std::fixed << std::setprecision(2) << std::setw(14) << comparison.baseline_median
+            << std::setw(14) << comparison.current_median << std::showpos << std::setw(9)
+            << comparison.change * 100 << '%' << std::noshowpos << std::setprecision(4) << std::setw(10)
+            << comparison.p_value << "  " << statusName(comparison.status) << '\n';
+        regressions += comparison.status == BenchmarkComparison::REGRESSION;
+        improvements += comparison.status == BenchmarkComparison::IMPROVEMENT;
+    }
+    out << std::defaultfloat << '\n' << regressions << " regression(s), " << improvements << " improvement(s)\n";
+}
+
+/**
+ * @return The Mann-Whitney U test of the two samples (p-value 1 if either is empty).
+ */
+MannWhitneyResult BenchmarkComparer::mannWhitney(const std::vector<double>& first,
+                                                 const std::vector<double>& second) {
+    MannWhitneyResult result;
+    size_t n1 = first.size();
+    size_t n2 = second.size();
+    if (n1 == 0 || n2 == 0) {
+        return result;
+    }
+
+    // Rank the pooled samples, giving tied values the average of their ranks
+    std::vector<std::pair<double, int>> pooled;
+    pooled.reserve(n1 + n2);
+    for (double value : first) {
+        pooled.emplace_back(value, 0);
+    }
+    for (double value : second) {
+        pooled.emplace_back(value, 1);
+    }
+    std::sort(pooled.begin(), pooled.end());
+
+    double first_rank_sum = 0;
+    double tie_term = 0; // Sum of t^3 - t over groups of t tied values
+    for (size_t i = 0; i < pooled.size();) {
+        size_t j = i;
+        while (j < pooled.size() && pooled[j].first == pooled[i].first) {
+            j++;
+        }
+        double average_rank = (i + 1 + j) / 2.0;
+        for (size_t k = i; k < j; k++) {
+            if (pooled[k].second == 0) {
+                first_rank_sum += average_rank;
+            }
+        }
+        double t = static_cast<double>(j - i);
+        tie_term += t * t * t - t;
+        i = j;
+    }
+
+    double n = static_cast<double>(n1 + n2);
+    result.u = first_rank_sum - n1 * (n1 + 1) / 2.0;
+    double mean = n1 * n2 / 2.0;
+    double variance = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)));
+    if (variance <= 0) {
+        return result; // Every value is identical
+    }
+
+    // Normal approximation with continuity correction; adequate from about 8 samples per run
+    double distance = std::fabs(result.u - mean) - 0.5;
+    result.z = (distance > 0 ? distance : 0) / std::sqrt(variance);
+    if (result.u < mean) {
+        result.z = -result.z;
+    }
+    result.p_value = std::erfc(std::fabs(result.z) / std::sqrt(2.0));
+    return result;
+}
+
+/**
+ * @return The status as shown in the report.
+ */
+const char* BenchmarkComparer::statusName(BenchmarkComparison::Status status) {
+    switch (status) {
+        case BenchmarkComparison::UNCHANGED: return "ok";
+        case BenchmarkComparison::REGRESSION: return "REGRESSION";
+        case BenchmarkComparison::IMPROVEMENT: return "improved";
+        case BenchmarkComparison::ADDED: return "new";
+        case BenchmarkComparison::REMOVED: return "missing";
+        default: return "unknown";
+    }
+}
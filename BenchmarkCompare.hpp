@@ -0,0 +1,93 @@
+/**
+ * @file BenchmarkCompare.hpp
+ * @brief This file contains the declaration of the BenchmarkComparer class, which compares benchmark
+ * results against a stored baseline and flags statistically significant slowdowns.
+ *
+ * Benchmarks are matched by name and size. A benchmark regressed when its median time per operation
+ * grew by more than the threshold AND a two-sided Mann-Whitney U test on the raw samples rejects
+ * "same distribution" at the chosen significance level. Requiring both keeps small but real
+ * shifts and large but noisy ones from failing the check.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef BENCHMARK_COMPARE_HPP
+#define BENCHMARK_COMPARE_HPP
+
+#include "Benchmark.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+/**
+ * The result of a Mann-Whitney U test of two samples.
+ */
+struct MannWhitneyResult {
+    double u = 0;       // U statistic of the first sample
+    double z = 0;       // Normal approximation of U, tie- and continuity-corrected
+    double p_value = 1; // Two-sided p-value
+};
+
+/**
+ * The comparison of one benchmark at one size.
+ */
+struct BenchmarkComparison {
+    enum Status { UNCHANGED, REGRESSION, IMPROVEMENT, ADDED, REMOVED };
+
+    std::string name;
+    int size = 0;
+    double baseline_median = 0; // ns per operation
+    double current_median = 0;  // ns per operation
+    double change = 0;          // current / baseline - 1
+    double p_value = 1;
+    Status status = UNCHANGED;
+};
+
+class BenchmarkComparer {
+public:
+    /**
+     * Options controlling what counts as a change.
+     */
+    struct Options {
+        double threshold = 0.10; // Minimum relative change of the median
+        double alpha = 0.01;     // Significance level of the Mann-Whitney test
+    };
+
+    /**
+     * @param options The thresholds applied to every benchmark.
+     */
+    explicit BenchmarkComparer(const Options& options);
+
+    /**
+     * @param baseline The stored results.
+     * @param current The results of the run under test.
+     * @return One comparison per benchmark of either run, in the order of `current` followed by
+     * the benchmarks only the baseline has.
+     */
+    std::vector<BenchmarkComparison> compare(const std::vector<BenchmarkResult>& baseline,
+                                             const std::vector<BenchmarkResult>& current) const;
+
+    /**
+     * @post Outputs one line per comparison, followed by the number of regressions.
+     */
+    static void printReport(const std::vector<BenchmarkComparison>& comparisons, std::ostream& out);
+
+    /**
+     * @param first The samples of one run.
+     * @param second The samples of the other run.
+     * @return The Mann-Whitney U test of the two samples (p-value 1 if either is empty).
+     */
+    static MannWhitneyResult mannWhitney(const std::vector<double>& first, const std::vector<double>& second);
+
+    /**
+     * @param status A comparison status.
+     * @return The status as shown in the report.
+     */
+    static const char* statusName(BenchmarkComparison::Status status);
+
+private:
+    Options options_;
+};
+
+#endif // BENCHMARK_COMPARE_HPP
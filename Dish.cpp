@@ -10,28 +10,193 @@
  */
 
 #include "Dish.hpp"
+#include "Instrumentation.hpp"
 #include <iostream>
-#include <iomanip> // For std::fixed and std::setprecision
-#include <cctype>  // For std::isalpha, std::isspace
+#include <charconv> // For std::to_chars
+#include <cmath>    // For std::signbit
+#include <cstring>  // For std::memcpy
+#include <functional> // For std::less
+#include <limits>
+#include <string_view>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define DISH_NAME_SIMD 1
+#include <immintrin.h>
+#endif
+
+// NAME_CHAR[c] is true if (unsigned char)c is accepted in a name: what std::isalpha(c) ||
+// std::isspace(c) returns in the "C" locale. The test suite compares all 256 entries with <cctype>.
+struct NameCharTable {
+    bool allowed[256];
+
+    constexpr NameCharTable() : allowed() {
+        for (int c = 'A'; c <= 'Z'; c++) {
+            allowed[c] = true;
+            allowed[c + ('a' - 'A')] = true;
+        }
+        for (int c = '\t'; c <= '\r'; c++) {  // \t \n \v \f \r
+            allowed[c] = true;
+        }
+        allowed[static_cast<unsigned char>(' ')] = true;
+    }
+};
+
+static constexpr NameCharTable NAME_CHAR;
+
+// Checks the characters one at a time
+static bool validNameChars(const char* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (!NAME_CHAR.allowed[static_cast<unsigned char>(data[i])]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#ifdef DISH_NAME_SIMD
+// The same test as NAME_CHAR on 16 bytes at once. Each unsigned range test x - lo <= hi - lo is done
+// as a signed compare after adding 0x80 - lo, which moves the range to start at -128.
+static inline __m128i nameCharMask128(__m128i bytes) {
+    __m128i letter = _mm_add_epi8(_mm_or_si128(bytes, _mm_set1_epi8(0x20)), _mm_set1_epi8(0x80 - 'a'));
+    __m128i control = _mm_add_epi8(bytes, _mm_set1_epi8(0x80 - '\t'));
+    return _mm_or_si128(_mm_or_si128(_mm_cmplt_epi8(letter, _mm_set1_epi8(-128 + 26)),
+                                     _mm_cmplt_epi8(control, _mm_set1_epi8(-128 + 5))),
+                        _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' ')));
+}
+
+static bool validNameCharsSse2(const char* data, size_t length) {
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(nameCharMask128(bytes)) != 0xFFFF) {
+            return false;
+        }
+    }
+    return validNameChars(data + i, length - i);
+}
+
+static __attribute__((target("avx2"))) bool validNameCharsAvx2(const char* data, size_t length) {
+    size_t i = 0;
+    for (; i + 32 <= length; i += 32) {
+        __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i letter = _mm256_add_epi8(_mm256_or_si256(bytes, _mm256_set1_epi8(0x20)),
+                                         _mm256_set1_epi8(0x80 - 'a'));
+        __m256i control = _mm256_add_epi8(bytes, _mm256_set1_epi8(0x80 - '\t'));
+        __m256i allowed = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 26), letter),
+                            _mm256_cmpgt_epi8(_mm256_set1_epi8(-128 + 5), control)),
+            _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' ')));
+        if (_mm256_movemask_epi8(allowed) != -1) {
+            return false;
+        }
+    }
+    // Clear the upper halves before running legacy SSE code, or every call pays a transition stall
+    _mm256_zeroupper();
+    return validNameCharsSse2(data + i, length - i);
+}
+
+// Uses AVX2 if the CPU has it; the choice is made once, on first use
+static bool validNameCharsLong(const char* data, size_t length) {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2 ? validNameCharsAvx2(data, length) : validNameCharsSse2(data, length);
+}
+#endif
 
 // Default Constructor
 Dish::Dish() 
-    : name_("UNKNOWN"), ingredients_({}), prep_time_(0), price_(0.0), cuisine_type_(CuisineType::OTHER) {
+    : name_("UNKNOWN"), ingredients_(), ingredient_count_(0), prep_time_(0), price_(0.0), cuisine_type_(CuisineType::OTHER) {
+}
+
+Dish::Dish(const allocator_type& allocator)
+    : name_("UNKNOWN", allocator), ingredients_(allocator), ingredient_count_(0), prep_time_(0), price_(0.0), cuisine_type_(CuisineType::OTHER) {
 }
 
 // Parameterized Constructor
-Dish::Dish(const std::string& name, const std::vector<std::string>& ingredients, int prep_time, double price, CuisineType cuisine_type)
-    : ingredients_(ingredients), prep_time_(prep_time), price_(price), cuisine_type_(cuisine_type) {
+Dish::Dish(const std::string& name, const std::vector<std::string>& ingredients, int prep_time, double price, CuisineType cuisine_type, const allocator_type& allocator)
+    : name_(allocator), ingredients_(allocator), ingredient_count_(0), prep_time_(prep_time), price_(price), cuisine_type_(cuisine_type) {
     setName(name);  // Use setName to validate the name
+    setIngredients(ingredients);
+}
+
+// Allocator-Extended Copy and Move Constructors
+Dish::Dish(const Dish& other, const allocator_type& allocator)
+    : name_(other.name_, allocator), ingredients_(other.ingredients_, allocator), ingredient_count_(other.ingredient_count_), prep_time_(other.prep_time_), price_(other.price_), cuisine_type_(other.cuisine_type_) {
+    INSTRUMENT_COUNT(dish_copies);
+}
+
+Dish::Dish(Dish&& other, const allocator_type& allocator)
+    : name_(std::move(other.name_), allocator), ingredients_(std::move(other.ingredients_), allocator), ingredient_count_(other.ingredient_count_), prep_time_(other.prep_time_), price_(other.price_), cuisine_type_(other.cuisine_type_) {
+    INSTRUMENT_COUNT(dish_moves);
+}
+
+#ifdef KITCHEN_INSTRUMENT
+// Counted Copy and Move Operations
+Dish::Dish(const Dish& other)
+    : name_(other.name_), ingredients_(other.ingredients_), ingredient_count_(other.ingredient_count_), prep_time_(other.prep_time_), price_(other.price_), cuisine_type_(other.cuisine_type_) {
+    INSTRUMENT_COUNT(dish_copies);
+}
+
+Dish::Dish(Dish&& other) noexcept
+    : name_(std::move(other.name_)), ingredients_(std::move(other.ingredients_)), ingredient_count_(other.ingredient_count_), prep_time_(other.prep_time_), price_(other.price_), cuisine_type_(other.cuisine_type_) {
+    INSTRUMENT_COUNT(dish_moves);
+}
+
+Dish& Dish::operator=(const Dish& other) {
+    name_ = other.name_;
+    ingredients_ = other.ingredients_;
+    ingredient_count_ = other.ingredient_count_;
+    prep_time_ = other.prep_time_;
+    price_ = other.price_;
+    cuisine_type_ = other.cuisine_type_;
+    INSTRUMENT_COUNT(dish_copies);
+    return *this;
 }
 
+Dish& Dish::operator=(Dish&& other) noexcept {
+    name_ = std::move(other.name_);
+    ingredients_ = std::move(other.ingredients_);
+    ingredient_count_ = other.ingredient_count_;
+    prep_time_ = other.prep_time_;
+    price_ = other.price_;
+    cuisine_type_ = other.cuisine_type_;
+    INSTRUMENT_COUNT(dish_moves);
+    return *this;
+}
+#endif
+
 // Accessor Functions
 std::string Dish::getName() const {
-    return name_;
+    return std::string(name_.data(), name_.size());
 }
 
 std::vector<std::string> Dish::getIngredients() const {
-    return ingredients_;
+    std::vector<std::string> ingredients;
+    ingredients.reserve(ingredient_count_);
+    for (std::string_view ingredient : getIngredientRange()) {
+        ingredients.emplace_back(ingredient);
+    }
+    return ingredients;
+}
+
+Dish::IngredientRange Dish::getIngredientRange() const {
+    return IngredientRange(ingredients_.data(), ingredient_count_);
+}
+
+size_t Dish::getIngredientCount() const {
+    return ingredient_count_;
+}
+
+size_t Dish::allocatedBytes() const {
+    std::less<const char*> before;
+    const char* object_begin = reinterpret_cast<const char*>(this);
+    const char* object_end = reinterpret_cast<const char*>(this + 1);
+    size_t bytes = 0;
+    for (const std::pmr::string* text : {&name_, &ingredients_}) {
+        // A short string lives in the object's own buffer and allocates nothing
+        bool inline_buffer = !before(text->data(), object_begin) && before(text->data(), object_end);
+        bytes += inline_buffer ? 0 : text->capacity() + 1;
+    }
+    return bytes;
 }
 
 int Dish::getPrepTime() const {
@@ -43,7 +208,15 @@ double Dish::getPrice() const {
 }
 
 std::string Dish::getCuisineType() const {
-    switch (cuisine_type_) {
+    return cuisineName(cuisine_type_);
+}
+
+Dish::CuisineType Dish::getCuisineTypeEnum() const {
+    return cuisine_type_;
+}
+
+const char* Dish::cuisineName(CuisineType type) {
+    switch (type) {
         case CuisineType::ITALIAN: return "ITALIAN";
         case CuisineType::MEXICAN: return "MEXICAN";
         case CuisineType::CHINESE: return "CHINESE";
@@ -54,17 +227,36 @@ std::string Dish::getCuisineType() const {
     }
 }
 
+Dish::allocator_type Dish::getAllocator() const {
+    return name_.get_allocator();
+}
+
 // Mutator Functions
 void Dish::setName(const std::string& name) {
     if (isValidName(name)) {
-        name_ = name;
+        name_.assign(name.data(), name.size());
     } else {
         name_ = "UNKNOWN";
     }
 }
 
 void Dish::setIngredients(const std::vector<std::string>& ingredients) {
-    ingredients_ = ingredients;
+    // One buffer: the end offset of every ingredient, then the ingredients back to back. clear()
+    // keeps its capacity, so refilling a dish of similar size does not allocate.
+    size_t table_bytes = ingredients.size() * sizeof(uint32_t);
+    size_t total_length = table_bytes;
+    for (const std::string& ingredient : ingredients) {
+        total_length += ingredient.size();
+    }
+    ingredients_.clear();
+    ingredients_.reserve(total_length);
+    ingredients_.resize(table_bytes);
+    for (size_t i = 0; i < ingredients.size(); ++i) {
+        ingredients_.append(ingredients[i]);
+        uint32_t end = static_cast<uint32_t>(ingredients_.size() - table_bytes);
+        std::memcpy(&ingredients_[i * sizeof(uint32_t)], &end, sizeof(end));
+    }
+    ingredient_count_ = static_cast<uint32_t>(ingredients.size());
 }
 
 void Dish::setPrepTime(const int& prep_time) {
@@ -81,18 +273,97 @@ void Dish::setCuisineType(const CuisineType& cuisine_type) {
 
 // Display Function
 void Dish::display() const {
-    std::cout << "Dish Name: " << name_ << std::endl;
-    std::cout << "Ingredients: ";
-    for (size_t i = 0; i < ingredients_.size(); ++i) {
-        std::cout << ingredients_[i];
-        if (i != ingredients_.size() - 1) {
-            std::cout << ", ";
+    display(std::cout);
+}
+
+void Dish::display(std::ostream& out) const {
+    // Most dishes fit on the stack; the rare one that does not is formatted a second time
+    char local[512];
+    size_t length = renderTo(local, sizeof(local));
+    if (length <= sizeof(local)) {
+        out.write(local, length);
+        return;
+    }
+    std::string text(length, '\0');
+    renderTo(&text[0], length);
+    out.write(text.data(), length);
+}
+
+// Appends to a fixed buffer, counting what does not fit
+class RenderBuffer {
+public:
+    RenderBuffer(char* buffer, size_t size) : next_(buffer), remaining_(size), length_(0) {}
+
+    void append(std::string_view text) {
+        size_t fitting = text.size() < remaining_ ? text.size() : remaining_;
+        if (fitting > 0) {
+            std::memcpy(next_, text.data(), fitting);
+            next_ += fitting;
+            remaining_ -= fitting;
         }
+        length_ += text.size();
     }
-    std::cout << std::endl;
-    std::cout << "Preparation Time: " << prep_time_ << " minutes" << std::endl;
-    std::cout << std::fixed << std::setprecision(2) << "Price: $" << price_ << std::endl;
-    std::cout << "Cuisine Type: " << getCuisineType() << std::endl;
+
+    template <typename T, typename... Format>
+    void appendNumber(T value, Format... format) {
+        char digits[320]; // Enough for any double in fixed notation
+        std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value, format...);
+        if (result.ec == std::errc()) {
+            append(std::string_view(digits, result.ptr - digits));
+        }
+    }
+
+    // Appends the price with two decimals, rounded like printf("%.2f") and std::to_chars: to
+    // nearest, ties to even, on the exact binary value (so 2.675, stored as 2.67499..., gives 2.67)
+    void appendPrice(double price) {
+        // The general to_chars with a precision is slow, and prices are small: where long double has
+        // a 64-bit mantissa, price * 100 is exact in it and the cents can be rounded directly
+        if (std::numeric_limits<long double>::digits >= 64 && price >= 0 && price < 1e15 && !std::signbit(price)) {
+            long double scaled = static_cast<long double>(price) * 100;
+            uint64_t cents = static_cast<uint64_t>(scaled);
+            long double fraction = scaled - cents;
+            if (fraction > 0.5L || (fraction == 0.5L && cents % 2 == 1)) {
+                cents++;
+            }
+            char digits[24];
+            char* end = std::to_chars(digits, digits + sizeof(digits), cents / 100).ptr;
+            end[0] = '.';
+            end[1] = static_cast<char>('0' + cents % 100 / 10);
+            end[2] = static_cast<char>('0' + cents % 10);
+            append(std::string_view(digits, end + 3 - digits));
+            return;
+        }
+        appendNumber(price, std::chars_format::fixed, 2);
+    }
+
+    size_t length() const { return length_; }
+
+private:
+    char* next_;
+    size_t remaining_;
+    size_t length_;
+};
+
+size_t Dish::renderTo(char* buffer, size_t size) const {
+    RenderBuffer out(buffer, size);
+    out.append("Dish Name: ");
+    out.append(name_);
+    out.append("\nIngredients: ");
+    IngredientRange ingredients = getIngredientRange();
+    for (size_t i = 0; i < ingredients.size(); ++i) {
+        out.append(ingredients[i]);
+        if (i != ingredients.size() - 1) {
+            out.append(", ");
+        }
+    }
+    out.append("\nPreparation Time: ");
+    out.appendNumber(prep_time_);
+    out.append(" minutes\nPrice: $");
+    out.appendPrice(price_);
+    out.append("\nCuisine Type: ");
+    out.append(cuisineName(cuisine_type_));
+    out.append("\n");
+    return out.length();
 }
 
 /**
@@ -103,7 +374,10 @@ void Dish::display() const {
         type, same preparation time, and the same price.
 */
 bool Dish::operator==(const Dish& rightHandSide) const {
-    return (name_ == rightHandSide.name_) &&
+    INSTRUMENT_COUNT(dish_compares);
+    // Compare the names as string views: their operator== checks the lengths first, which the
+    // generic basic_string comparison used for std::pmr::string does not
+    return (std::string_view(name_) == std::string_view(rightHandSide.name_)) &&
            (cuisine_type_ == rightHandSide.cuisine_type_) &&
            (prep_time_ == rightHandSide.prep_time_) &&
            (price_ == rightHandSide.price_);
@@ -120,12 +394,45 @@ bool Dish::operator!=(const Dish& rightHandSide) const {
     return !(*this == rightHandSide);  // Returns opposite of operator== result
 }
 
-// Helper function to check if the name is valid
-bool Dish::isValidName(const std::string& name) const {
-    for (char c : name) {
-        if (!std::isalpha(c) && !std::isspace(c)) {  // Check if each character is a letter or space
-            return false;  // Name contains non-alphabetic characters other than spaces
-        }
+/**
+    @return : A 64-bit hash of the fields `operator==` compares. Equal dishes
+    always have equal hashes.
+*/
+uint64_t Dish::hash() const {
+    // FNV-1a over the name, then the other fields mixed in with the splitmix64 finalizer
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : name_) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+    }
+    // 0.0 == -0.0, so both must hash the same
+    double price = price_ == 0.0 ? 0.0 : price_;
+    uint64_t price_bits;
+    std::memcpy(&price_bits, &price, sizeof(price_bits));
+    hash ^= price_bits + 0x9E3779B97F4A7C15ULL + (static_cast<uint64_t>(static_cast<uint32_t>(prep_time_)) << 8) + cuisine_type_;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    return hash ^ (hash >> 31);
+}
+
+// Checks if the name is valid
+bool Dish::isValidName(std::string_view name) {
+#ifdef DISH_NAME_SIMD
+    // Most dish names are shorter than one vector; the table is faster for those
+    if (name.size() >= 16) {
+        return validNameCharsLong(name.data(), name.size());
+    }
+#endif
+    return validNameChars(name.data(), name.size());
+}
+
+// Validates many names in one call
+size_t Dish::validateNames(const std::vector<std::string>& names, std::vector<bool>& valid) {
+    valid.resize(names.size());
+    size_t valid_count = 0;
+    for (size_t i = 0; i < names.size(); i++) {
+        bool name_valid = isValidName(names[i]);
+        valid[i] = name_valid;
+        valid_count += name_valid;
     }
-    return true;  // Name is valid
+    return valid_count;
 }
@@ -5,6 +5,18 @@
  * The Dish class includes attributes such as name, ingredients, preparation time, price, and cuisine type.
  * It provides constructors, accessor and mutator functions, and a display function to manage and present
  * the details of a dish.
+ *
+ * Dish is allocator-aware: the name and ingredient strings live in memory from a std::pmr memory
+ * resource (the default heap unless one is given), and a std::pmr container of Dish objects passes
+ * its allocator on to them. Assignment keeps the target's allocator, so copying a dish into a slot
+ * that uses an arena copies the strings into that arena. The accessors and mutators still take and
+ * return ordinary std::string and std::vector values.
+ *
+ * The ingredients are stored in one character buffer: a small table of where each ingredient ends,
+ * followed by the ingredients back to back. A dish therefore holds at most two allocations (name and
+ * ingredients) however many ingredients it has, and copying one copies two flat buffers.
+ * getIngredientRange() iterates them as std::string_view without copying; getIngredients() still
+ * returns a vector of strings.
  * 
  * @date 09/30/2024
  * @author Mitchell Lipyansky
@@ -13,7 +25,15 @@
 #ifndef DISH_HPP
 #define DISH_HPP
 
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <iterator>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 class Dish {
@@ -21,6 +41,66 @@ public:
     // CuisineType enum definition
     enum CuisineType { ITALIAN, MEXICAN, CHINESE, INDIAN, AMERICAN, FRENCH, OTHER };
 
+    // The allocator the strings and the ingredient list use (uses-allocator construction)
+    using allocator_type = std::pmr::polymorphic_allocator<char>;
+
+    /**
+     * A read-only view of a dish's ingredients, each one a std::string_view into the dish. The range
+     * and its iterators point into the dish only, so an iterator may outlive the range it came
+     * from; all are valid until the dish is changed or destroyed.
+     */
+    class IngredientRange {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = std::string_view;
+
+            /**
+             * @param offsets The dish's offset table.
+             * @param characters The first character of the first ingredient.
+             * @param index The position of the ingredient.
+             */
+            inline iterator(const char* offsets, const char* characters, size_t index);
+            inline std::string_view operator*() const;
+            inline iterator& operator++();
+            inline iterator operator++(int);
+            inline bool operator==(const iterator& other) const;
+            inline bool operator!=(const iterator& other) const;
+
+        private:
+            const char* offsets_;
+            const char* characters_;
+            size_t index_;
+        };
+
+        /**
+         * @param buffer The start of a dish's ingredient buffer (offset table, then characters).
+         * @param count The number of ingredients in it.
+         */
+        inline IngredientRange(const char* buffer, size_t count);
+        inline iterator begin() const;
+        inline iterator end() const;
+        inline size_t size() const;
+        inline bool empty() const;
+
+        /**
+         * @param index An index less than size().
+         * @return The ingredient at that position.
+         */
+        inline std::string_view operator[](size_t index) const;
+
+    private:
+        const char* buffer_;
+        size_t count_;
+
+        // The offset, relative to the first character, just past ingredient `index` (-1 gives 0)
+        static inline uint32_t endOf(const char* offsets, size_t index);
+    };
+
     // Constructors
     /**
      * Default constructor.
@@ -33,6 +113,12 @@ public:
      */
     Dish();
 
+    /**
+     * Default constructor using the given allocator.
+     * @param allocator The allocator for the name and ingredients.
+     */
+    explicit Dish(const allocator_type& allocator);
+
     /**
      * Parameterized constructor.
      * @param name A reference to the name of the dish.
@@ -40,9 +126,34 @@ public:
      * @param prep_time The preparation time in minutes (default is 0).
      * @param price The price of the dish (default is 0.0).
      * @param cuisine_type The cuisine type of the dish (a CuisineType enum) with default value OTHER.
+     * @param allocator The allocator for the name and ingredients (default is the default memory resource).
      * @post The private members are set to the values of the corresponding parameters.
      */
-    Dish(const std::string& name, const std::vector<std::string>& ingredients = {}, int prep_time = 0, double price = 0.0, CuisineType cuisine_type = CuisineType::OTHER);
+    Dish(const std::string& name, const std::vector<std::string>& ingredients = {}, int prep_time = 0, double price = 0.0, CuisineType cuisine_type = CuisineType::OTHER, const allocator_type& allocator = {});
+
+    /**
+     * Allocator-extended copy and move constructors.
+     * @param other The dish to copy or move from.
+     * @param allocator The allocator of the new dish. A move from a dish with a different
+     * allocator copies the strings.
+     */
+    Dish(const Dish& other, const allocator_type& allocator);
+    Dish(Dish&& other, const allocator_type& allocator);
+
+#ifdef KITCHEN_INSTRUMENT
+    // Copy and move operations that update OpCounters (see Instrumentation.hpp).
+    // Without KITCHEN_INSTRUMENT the implicitly generated ones are used.
+    Dish(const Dish& other);
+    Dish(Dish&& other) noexcept;
+    Dish& operator=(const Dish& other);
+    Dish& operator=(Dish&& other) noexcept;
+#endif
+
+    /**
+     * Exchanges two dishes member by member, without allocating or copying characters.
+     * @param other A dish with the same allocator, e.g. another slot of the same Kitchen.
+     */
+    inline void swap(Dish& other) noexcept;
 
     // Accessors
     /**
@@ -55,6 +166,22 @@ public:
      */
     std::vector<std::string> getIngredients() const;
 
+    /**
+     * @return The ingredients as string views into the dish, without copying them.
+     */
+    IngredientRange getIngredientRange() const;
+
+    /**
+     * @return The number of ingredients used in the dish (without copying the list).
+     */
+    size_t getIngredientCount() const;
+
+    /**
+     * @return The bytes the dish's name and ingredients hold outside the Dish object (0 for short
+     * strings kept inline).
+     */
+    size_t allocatedBytes() const;
+
     /**
      * @return The preparation time in minutes.
      */
@@ -70,6 +197,22 @@ public:
      */
     std::string getCuisineType() const;
 
+    /**
+     * @return The cuisine type of the dish as a CuisineType enum.
+     */
+    CuisineType getCuisineTypeEnum() const;
+
+    /**
+     * @param type A cuisine type.
+     * @return Its name, e.g. "ITALIAN": the form in which every cuisine type is printed and parsed.
+     */
+    static const char* cuisineName(CuisineType type);
+
+    /**
+     * @return The allocator the dish's strings use.
+     */
+    allocator_type getAllocator() const;
+
     // Mutators
     /**
      * Sets the name of the dish.
@@ -81,7 +224,7 @@ public:
     /**
      * Sets the list of ingredients.
      * @param ingredients A reference to the new list of ingredients.
-     * @post Sets the private member `ingredients_` to the value of the parameter.
+     * @post Stores the ingredients, and where each one ends, in the single buffer `ingredients_`.
      */
     void setIngredients(const std::vector<std::string>& ingredients);
 
@@ -120,6 +263,25 @@ public:
      */
     void display() const;
 
+    /**
+     * Displays the details of the dish, in the format of display(), on the given stream.
+     * @param out The stream to write to.
+     * @post The dish is formatted into a local buffer and handed to the stream in one write. The
+     * stream is not flushed and its formatting flags are not changed.
+     */
+    void display(std::ostream& out) const;
+
+    /**
+     * Formats the details of the dish, exactly as display() prints them, into a character buffer.
+     * The price is formatted with std::to_chars, which rounds the same way as the stream does.
+     * @param buffer The buffer to write to (may be null if size is 0).
+     * @param size The size of the buffer.
+     * @post The first min(size, return value) characters of the text are in the buffer. No null
+     * terminator is written.
+     * @return The length of the full text; if it is larger than size, the text was cut off.
+     */
+    size_t renderTo(char* buffer, size_t size) const;
+
     /**
     @param : A const reference to the right-hand side of the `==` operator.
     @return : Returns true if the right-hand side dish is "equal", false
@@ -138,20 +300,109 @@ public:
     */
     bool operator!=(const Dish& rightHandSide) const;
 
-private:
-    std::string name_;
-    std::vector<std::string> ingredients_;
-    int prep_time_;
-    double price_;
-    CuisineType cuisine_type_;
+    /**
+     * @return A 64-bit hash of the fields `operator==` compares (name, cuisine type, preparation
+     * time and price). Equal dishes always have equal hashes.
+     */
+    uint64_t hash() const;
 
-    // Helper function to check if the name is valid
     /**
-     * Checks if the name is valid.
+     * Checks if a name is valid: every character is a letter or white space, as std::isalpha and
+     * std::isspace classify it in the "C" locale (the program never changes the locale). Uses a
+     * lookup table, and SSE2/AVX2 for 16 characters at a time where the CPU has them.
      * @param name The name to be validated.
      * @return True if the name contains only alphabetic characters and spaces; false otherwise.
      */
-    bool isValidName(const std::string& name) const;
+    static bool isValidName(std::string_view name);
+
+    /**
+     * Validates many names in one call, e.g. the rows of an import, before any Dish is built.
+     * @param names The names to be validated.
+     * @param valid Set to one entry per name: isValidName(names[i]).
+     * @return The number of valid names.
+     */
+    static size_t validateNames(const std::vector<std::string>& names, std::vector<bool>& valid);
+
+private:
+    std::pmr::string name_;
+    std::pmr::string ingredients_;  // The end offset (uint32_t) of every ingredient, then the ingredients back to back
+    uint32_t ingredient_count_;
+    int prep_time_;
+    double price_;
+    CuisineType cuisine_type_;
 };
 
+// ********* INLINE FUNCTIONS **************//
+
+inline void Dish::swap(Dish& other) noexcept {
+    // Equal allocators, so each string swap exchanges pointers (or the short-string buffers)
+    name_.swap(other.name_);
+    ingredients_.swap(other.ingredients_);
+    std::swap(ingredient_count_, other.ingredient_count_);
+    std::swap(prep_time_, other.prep_time_);
+    std::swap(price_, other.price_);
+    std::swap(cuisine_type_, other.cuisine_type_);
+}
+
+inline Dish::IngredientRange::IngredientRange(const char* buffer, size_t count) : buffer_(buffer), count_(count) {
+}
+
+inline Dish::IngredientRange::iterator Dish::IngredientRange::begin() const {
+    return iterator(buffer_, buffer_ + count_ * sizeof(uint32_t), 0);
+}
+
+inline Dish::IngredientRange::iterator Dish::IngredientRange::end() const {
+    return iterator(buffer_, buffer_ + count_ * sizeof(uint32_t), count_);
+}
+
+inline size_t Dish::IngredientRange::size() const {
+    return count_;
+}
+
+inline bool Dish::IngredientRange::empty() const {
+    return count_ == 0;
+}
+
+inline uint32_t Dish::IngredientRange::endOf(const char* offsets, size_t index) {
+    uint32_t end = 0;
+    if (index != static_cast<size_t>(-1)) {
+        // The buffer has no alignment guarantee, so read the offset bytewise (a plain load on x86)
+        std::memcpy(&end, offsets + index * sizeof(uint32_t), sizeof(end));
+    }
+    return end;
+}
+
+inline std::string_view Dish::IngredientRange::operator[](size_t index) const {
+    uint32_t start = endOf(buffer_, index - 1);
+    return std::string_view(buffer_ + count_ * sizeof(uint32_t) + start, endOf(buffer_, index) - start);
+}
+
+inline Dish::IngredientRange::iterator::iterator(const char* offsets, const char* characters, size_t index)
+    : offsets_(offsets), characters_(characters), index_(index) {
+}
+
+inline std::string_view Dish::IngredientRange::iterator::operator*() const {
+    uint32_t start = endOf(offsets_, index_ - 1);
+    return std::string_view(characters_ + start, endOf(offsets_, index_) - start);
+}
+
+inline Dish::IngredientRange::iterator& Dish::IngredientRange::iterator::operator++() {
+    index_++;
+    return *this;
+}
+
+inline Dish::IngredientRange::iterator Dish::IngredientRange::iterator::operator++(int) {
+    iterator before = *this;
+    index_++;
+    return before;
+}
+
+inline bool Dish::IngredientRange::iterator::operator==(const iterator& other) const {
+    return index_ == other.index_ && offsets_ == other.offsets_;
+}
+
+inline bool Dish::IngredientRange::iterator::operator!=(const iterator& other) const {
+    return !(*this == other);
+}
+
 #endif // DISH_HPP
@@ -0,0 +1,139 @@
+/**
+ * @file Histogram.cpp
+ * @brief This file contains the implementation of the LatencyHistogram class, an HDR-style log-linear
+ * histogram of nanosecond latencies.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Histogram.hpp"
+#include <cmath> // For std::ceil
+
+/**
+ * Default constructor.
+ * @post The histogram is empty.
+ */
+LatencyHistogram::LatencyHistogram() : counts_(BUCKET_COUNT, 0), total_(0), min_(UINT64_MAX), max_(0) {
+}
+
+/**
+ * @post Every bucket of `other` has been added to this histogram.
+ */
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        counts_[i] += other.counts_[i];
+    }
+    total_ += other.total_;
+    if (other.min_ < min_) {
+        min_ = other.min_;
+    }
+    if (other.max_ > max_) {
+        max_ = other.max_;
+    }
+}
+
+/**
+ * @post The histogram is empty.
+ */
+void LatencyHistogram::reset() {
+    counts_.assign(BUCKET_COUNT, 0);
+    total_ = 0;
+    min_ = UINT64_MAX;
+    max_ = 0;
+}
+
+/**
+ * @return The number of recorded values.
+ */
+uint64_t LatencyHistogram::count() const {
+    return total_;
+}
+
+/**
+ * @return The smallest recorded value, or 0 if the histogram is empty.
+ */
+uint64_t LatencyHistogram::min() const {
+    return total_ == 0 ? 0 : min_;
+}
+
+/**
+ * @return The largest recorded value, or 0 if the histogram is empty.
+ */
+uint64_t LatencyHistogram::max() const {
+    return max_;
+}
+
+/**
+ * @return The mean of the recorded values (to bucket precision), or 0 if the histogram is empty.
+ */
+double LatencyHistogram::mean() const {
+    if (total_ == 0) {
+        return 0;
+    }
+    double sum = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        if (counts_[i] != 0) {
+            // Use the middle of the bucket as its representative value
+            double middle = (static_cast<double>(bucketLowerBound(i)) + bucketUpperBound(i)) / 2;
+            sum += middle * counts_[i];
+        }
+    }
+    return sum / total_;
+}
+
+/**
+ * @return The highest value equivalent to the given percentile, or 0 if the histogram is empty.
+ */
+uint64_t LatencyHistogram::valueAtPercentile(double percentile) const {
+    if (total_ == 0) {
+        return 0;
+    }
+    if (percentile > 100) {
+        percentile = 100;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(percentile / 100 * total_));
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++) {
+        seen += counts_[i];
+        if (seen >= rank) {
+            uint64_t value = bucketUpperBound(i);
+            return value < max_ ? value : max_;
+        }
+    }
+    return max_;
+}
+
+/**
+ * @return The smallest value counted by the bucket.
+ */
+uint64_t LatencyHistogram::bucketLowerBound(int index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    int shift = index / SUB_BUCKET_COUNT - 1;
+    uint64_t sub_bucket = index % SUB_BUCKET_COUNT;
+    return (SUB_BUCKET_COUNT + sub_bucket) << shift;
+}
+
+/**
+ * @return The largest value counted by the bucket.
+ */
+uint64_t LatencyHistogram::bucketUpperBound(int index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+    int shift = index / SUB_BUCKET_COUNT - 1;
+    return bucketLowerBound(index) + ((1ULL << shift) - 1);
+}
+
+/**
+ * @return The number of values recorded in the bucket.
+ */
+uint64_t LatencyHistogram::bucketCount(int index) const {
+    return counts_[index];
+}
@@ -0,0 +1,130 @@
+/**
+ * @file Histogram.hpp
+ * @brief This file contains the declaration of the LatencyHistogram class, an HDR-style log-linear
+ * histogram of nanosecond latencies.
+ *
+ * Values below 2^SUB_BUCKET_BITS are counted exactly. Above that, every power-of-two range is split
+ * into 2^SUB_BUCKET_BITS equal sub-buckets, so any recorded value is known to within 1/64 (about
+ * 1.6%) of itself across the full 64-bit range. Recording is a count-leading-zeros, a shift and an
+ * increment.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef HISTOGRAM_HPP
+#define HISTOGRAM_HPP
+
+#include <cstdint>
+#include <vector>
+
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 6;
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const int BUCKET_COUNT = (65 - SUB_BUCKET_BITS) * SUB_BUCKET_COUNT;
+
+    /**
+     * Default constructor.
+     * @post The histogram is empty.
+     */
+    LatencyHistogram();
+
+    /**
+     * @param value A latency in nanoseconds.
+     * @param count The number of times `value` occurred (default is 1).
+     * @post The bucket containing `value` is incremented by `count`.
+     */
+    inline void record(uint64_t value, uint64_t count = 1);
+
+    /**
+     * @param other Another histogram.
+     * @post Every bucket of `other` has been added to this histogram.
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * @post The histogram is empty.
+     */
+    void reset();
+
+    /**
+     * @return The number of recorded values.
+     */
+    uint64_t count() const;
+
+    /**
+     * @return The smallest recorded value, or 0 if the histogram is empty.
+     */
+    uint64_t min() const;
+
+    /**
+     * @return The largest recorded value, or 0 if the histogram is empty.
+     */
+    uint64_t max() const;
+
+    /**
+     * @return The mean of the recorded values (to bucket precision), or 0 if the histogram is empty.
+     */
+    double mean() const;
+
+    /**
+     * @param percentile A percentile in [0, 100].
+     * @return The highest value equivalent to the given percentile (at least `percentile` percent of
+     * the recorded values are less than or equal to it), or 0 if the histogram is empty.
+     */
+    uint64_t valueAtPercentile(double percentile) const;
+
+    /**
+     * @param value A latency in nanoseconds.
+     * @return The index of the bucket counting `value`.
+     */
+    static inline int bucketIndex(uint64_t value);
+
+    /**
+     * @param index A bucket index.
+     * @return The smallest value counted by the bucket.
+     */
+    static uint64_t bucketLowerBound(int index);
+
+    /**
+     * @param index A bucket index.
+     * @return The largest value counted by the bucket.
+     */
+    static uint64_t bucketUpperBound(int index);
+
+    /**
+     * @param index A bucket index.
+     * @return The number of values recorded in the bucket.
+     */
+    uint64_t bucketCount(int index) const;
+
+private:
+    std::vector<uint64_t> counts_;
+    uint64_t total_;
+    uint64_t min_;
+    uint64_t max_;
+};
+
+// ********* INLINE FUNCTIONS **************//
+
+inline int LatencyHistogram::bucketIndex(uint64_t value) {
+    if (value < static_cast<uint64_t>(SUB_BUCKET_COUNT)) {
+        return static_cast<int>(value);
+    }
+    int shift = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKET_COUNT + static_cast<int>((value >> shift) - SUB_BUCKET_COUNT);
+}
+
+inline void LatencyHistogram::record(uint64_t value, uint64_t count) {
+    counts_[bucketIndex(value)] += count;
+    total_ += count;
+    if (value < min_) {
+        min_ = value;
+    }
+    if (value > max_) {
+        max_ = value;
+    }
+}
+
+#endif // HISTOGRAM_HPP
@@ -0,0 +1,144 @@
+/**
+ * @file Instrumentation.hpp
+ * @brief This file contains the declaration of the OpCounters class, compile-time-optional operation
+ * counters for ArrayBag, Dish and Kitchen.
+ *
+ * When the program is compiled with -DKITCHEN_INSTRUMENT (`make INSTRUMENT=1`), the counting macros
+ * below count Dish comparisons, copies and moves, the slots scanned by a search for a dish, the
+ * elements moved to fill the slot of a removed one and the calls to every Kitchen function. A
+ * Kitchen searches with Kitchen::findDish and moves dishes with Kitchen::removeSlot and shiftSlot; a
+ * plain ArrayBag counts the same in getIndexOf and remove. Otherwise the macros expand to nothing
+ * and Dish keeps its implicit copy and move operations, so there is no overhead.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * A point-in-time copy of every counter.
+ */
+struct OpCounterSnapshot {
+    enum KitchenMethod {
+        NEW_ORDER, SERVE_DISH, GET_PREP_TIME_SUM, CALCULATE_AVG_PREP_TIME, ELABORATE_DISH_COUNT,
+        CALCULATE_ELABORATE_PERCENTAGE, TALLY_CUISINE_TYPES, RELEASE_DISHES_BELOW_PREP_TIME,
+        RELEASE_DISHES_OF_CUISINE_TYPE, KITCHEN_REPORT, KITCHEN_METHOD_COUNT
+    };
+
+    uint64_t dish_compares = 0;    // Calls of Dish::operator==
+    uint64_t dish_copies = 0;      // Dish copy constructions and copy assignments
+    uint64_t dish_moves = 0;       // Dish move constructions and move assignments
+    uint64_t slots_scanned = 0;    // Slots examined by Kitchen::findDish (ArrayBag::getIndexOf)
+    uint64_t elements_shifted = 0; // Dishes moved by Kitchen::removeSlot and shiftSlot (ArrayBag::remove)
+    uint64_t kitchen_calls[KITCHEN_METHOD_COUNT] = {};
+
+    /**
+     * @param earlier A snapshot taken before this one.
+     * @return The counts accumulated between the two snapshots.
+     */
+    OpCounterSnapshot operator-(const OpCounterSnapshot& earlier) const;
+
+    /**
+     * @param method A Kitchen method.
+     * @return The name of the method.
+     */
+    static const char* methodName(int method);
+};
+
+class OpCounters {
+public:
+    /**
+     * @return True if the program was compiled with KITCHEN_INSTRUMENT.
+     */
+    static constexpr bool enabled() {
+#ifdef KITCHEN_INSTRUMENT
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @return The current value of every counter (all zero when instrumentation is compiled out).
+     */
+    static OpCounterSnapshot snapshot();
+
+    /**
+     * @post Every counter is zero.
+     */
+    static void reset();
+
+    // Counter storage; use the macros below rather than touching these directly.
+    // Relaxed atomics keep counts exact if several threads use the counted classes.
+    static inline std::atomic<uint64_t> dish_compares{0};
+    static inline std::atomic<uint64_t> dish_copies{0};
+    static inline std::atomic<uint64_t> dish_moves{0};
+    static inline std::atomic<uint64_t> slots_scanned{0};
+    static inline std::atomic<uint64_t> elements_shifted{0};
+    static inline std::atomic<uint64_t> kitchen_calls[OpCounterSnapshot::KITCHEN_METHOD_COUNT] = {};
+};
+
+#ifdef KITCHEN_INSTRUMENT
+#define INSTRUMENT_COUNT(counter) (OpCounters::counter.fetch_add(1, std::memory_order_relaxed))
+#define INSTRUMENT_ADD(counter, amount) (OpCounters::counter.fetch_add((amount), std::memory_order_relaxed))
+#define INSTRUMENT_CALL(method) \
+    (OpCounters::kitchen_calls[OpCounterSnapshot::method].fetch_add(1, std::memory_order_relaxed))
+#else
+#define INSTRUMENT_COUNT(counter) ((void)0)
+#define INSTRUMENT_ADD(counter, amount) ((void)0)
+#define INSTRUMENT_CALL(method) ((void)0)
+#endif
+
+// ********* INLINE FUNCTIONS **************//
+
+inline OpCounterSnapshot OpCounterSnapshot::operator-(const OpCounterSnapshot& earlier) const {
+    OpCounterSnapshot difference;
+    difference.dish_compares = dish_compares - earlier.dish_compares;
+    difference.dish_copies = dish_copies - earlier.dish_copies;
+    difference.dish_moves = dish_moves - earlier.dish_moves;
+    difference.slots_scanned = slots_scanned - earlier.slots_scanned;
+    difference.elements_shifted = elements_shifted - earlier.elements_shifted;
+    for (int i = 0; i < KITCHEN_METHOD_COUNT; i++) {
+        difference.kitchen_calls[i] = kitchen_calls[i] - earlier.kitchen_calls[i];
+    }
+    return difference;
+}
+
+inline const char* OpCounterSnapshot::methodName(int method) {
+    static const char* const NAMES[KITCHEN_METHOD_COUNT] = {
+        "newOrder", "serveDish", "getPrepTimeSum", "calculateAvgPrepTime", "elaborateDishCount",
+        "calculateElaboratePercentage", "tallyCuisineTypes", "releaseDishesBelowPrepTime",
+        "releaseDishesOfCuisineType", "kitchenReport"};
+    return (method >= 0 && method < KITCHEN_METHOD_COUNT) ? NAMES[method] : "unknown";
+}
+
+inline OpCounterSnapshot OpCounters::snapshot() {
+    OpCounterSnapshot snapshot;
+    snapshot.dish_compares = dish_compares.load(std::memory_order_relaxed);
+    snapshot.dish_copies = dish_copies.load(std::memory_order_relaxed);
+    snapshot.dish_moves = dish_moves.load(std::memory_order_relaxed);
+    snapshot.slots_scanned = slots_scanned.load(std::memory_order_relaxed);
+    snapshot.elements_shifted = elements_shifted.load(std::memory_order_relaxed);
+    for (int i = 0; i < OpCounterSnapshot::KITCHEN_METHOD_COUNT; i++) {
+        snapshot.kitchen_calls[i] = kitchen_calls[i].load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+inline void OpCounters::reset() {
+    dish_compares.store(0, std::memory_order_relaxed);
+    dish_copies.store(0, std::memory_order_relaxed);
+    dish_moves.store(0, std::memory_order_relaxed);
+    slots_scanned.store(0, std::memory_order_relaxed);
+    elements_shifted.store(0, std::memory_order_relaxed);
+    for (int i = 0; i < OpCounterSnapshot::KITCHEN_METHOD_COUNT; i++) {
+        kitchen_calls[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+#endif // INSTRUMENTATION_HPP
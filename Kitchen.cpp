@@ -10,15 +10,158 @@
  */
 
 #include "Kitchen.hpp"
+#include "AllocTracker.hpp"
 #include "Dish.hpp"
+#include "Instrumentation.hpp"
+#include "KitchenLatency.hpp"
+#include "Trace.hpp"
+#include <algorithm>  // For std::sort, std::lower_bound, std::fill
+#include <charconv>  // For std::to_chars
+#include <deque>
 #include <cmath>  // For rounding
 #include <iomanip>  // For setting precision
+#include <new>  // For placement new
+#include <ostream>
+#include <string>
+#include <utility>  // For std::swap
+
+/**
+  * The undo journal: one entry per public change, oldest first, plus the
+  entries undone since the last change. An entry's steps are replayed
+  backwards to undo it and forwards to redo it.
+*/
+struct Kitchen::Journal {
+    struct Step {
+        // REMOVE_SLOT filled the slot with the last dish; REMOVE_SHIFTING shifted the later dishes down
+        enum Kind : uint8_t { APPEND, REMOVE_SLOT, REMOVE_SHIFTING, REMOVE_ALL };
+        Kind kind;
+        int32_t slot;       // The slot appended to or removed from
+        int32_t first_dish; // Index into Entry::dishes of the step's dish(es); -1 for an APPEND not yet undone
+        int32_t dish_count; // Dishes of a REMOVE_ALL
+    };
+
+    struct Entry {
+        std::vector<Step> steps;
+        std::vector<Dish> dishes;    // Removed dishes, and appended ones once undone, on the global heap
+        std::vector<uint64_t> hashes; // hashes[i] is dishes[i].hash()
+        int prep_time_delta = 0;
+        int elaborate_delta = 0;
+        int cuisine_deltas[CUISINE_TYPE_COUNT] = {};
+        size_t bytes = 0;
+    };
+
+    size_t budget_bytes;
+    size_t bytes = 0;
+    std::deque<Entry> undo;  // Oldest first
+    std::deque<Entry> redo;  // Most recently undone last
+    Entry open;              // The change being recorded
+    int depth = 0;           // Nesting of ChangeScope; steps are recorded only inside one
+    int prep_time_before = 0;
+    int elaborate_before = 0;
+    int cuisine_before[CUISINE_TYPE_COUNT] = {};
+
+    explicit Journal(size_t budget) : budget_bytes(budget) {
+    }
+
+    // The memory an entry holds
+    static size_t entryBytes(const Entry& entry) {
+        size_t total = sizeof(Entry) + entry.steps.capacity() * sizeof(Step) +
+                       entry.dishes.capacity() * sizeof(Dish) + entry.hashes.capacity() * sizeof(uint64_t);
+        for (const Dish& dish : entry.dishes) {
+            total += dish.allocatedBytes();
+        }
+        return total;
+    }
+
+    // Drops the oldest entries, then the farthest redo entries, until within the budget
+    void enforceBudget() {
+        while (bytes > budget_bytes && !undo.empty()) {
+            bytes -= undo.front().bytes;
+            undo.pop_front();
+        }
+        while (bytes > budget_bytes && !redo.empty()) {
+            bytes -= redo.front().bytes;
+            redo.pop_front();
+        }
+    }
+
+    void clearHistory() {
+        undo.clear();
+        redo.clear();
+        bytes = 0;
+    }
+
+    // Copies the dish in a slot into the entry; returns its index there
+    static int32_t keepDish(Entry& entry, const Dish& dish, uint64_t hash) {
+        entry.dishes.push_back(dish);
+        entry.hashes.push_back(hash);
+        return static_cast<int32_t>(entry.dishes.size() - 1);
+    }
+};
 
 /**
   * Default constructor.
   * Default-initializes all private members.
 */
-Kitchen::Kitchen() : totalprep_time_(0), countelaborate(0) {
+Kitchen::Kitchen() : totalprep_time_(0), countelaborate(0), cuisine_counts_(), version_(1), report_line_versions_(), report_version_(0), events_(nullptr) {
+    // ArrayBag default-constructed the slots on the global heap; rebind them to the arena
+    for (int i = 0; i < DEFAULT_CAPACITY; i++) {
+        items_[i].~Dish();
+        new (&items_[i]) Dish(Dish::allocator_type(&arena_));
+    }
+}
+
+/**
+  * Copy constructor.
+  * @param : The kitchen to copy. The copy has its own arena; the dishes are
+  copied into it.
+*/
+Kitchen::Kitchen(const Kitchen& other) : Kitchen() {
+    *this = other;
+}
+
+/**
+  * Copy assignment operator.
+  * @param : The kitchen to copy.
+  * @post : Releases this kitchen's arena, then copies the dishes of `other`
+  into it.
+*/
+Kitchen& Kitchen::operator=(const Kitchen& other) {
+    if (this != &other) {
+        if (journal_ != nullptr) {
+            journal_->clearHistory(); // The entries describe dishes this kitchen no longer has
+        }
+        removeAll();
+        // Assignment keeps each slot's allocator, so the strings are copied into this arena
+        for (int i = 0; i < other.item_count_; i++) {
+            items_[i] = other.items_[i];
+            hot_[i] = other.hot_[i];
+        }
+        item_count_ = other.item_count_;
+        totalprep_time_ = other.totalprep_time_;
+        countelaborate = other.countelaborate;
+        for (int i = 0; i < CUISINE_TYPE_COUNT; i++) {
+            cuisine_counts_[i] = other.cuisine_counts_[i];
+        }
+    }
+    return *this;
+}
+
+/**
+  * Destructor.
+  * @post : Releases the arena in one step.
+*/
+Kitchen::~Kitchen() {
+    resetSlots();
+}
+
+/**
+  * @post : Removes every dish, resets the statistics and releases the
+  arena in one step.
+*/
+void Kitchen::clear() {
+    ChangeScope scope(*this);
+    publishRelease(removeAll(), -1);
 }
 
 /**
@@ -32,24 +175,262 @@ Kitchen::Kitchen() : totalprep_time_(0), countelaborate(0) {
            `Dish` is already in the kitchen.
 */
 bool Kitchen::newOrder(const Dish& new_dish) {
-    // Check if the dish already exists in the kitchen
-    if (contains(new_dish)) {
-        return false;
+    INSTRUMENT_CALL(NEW_ORDER);
+    KitchenLatency::Timer timer(KitchenLatency::NEW_ORDER);
+    TRACE_SCOPE("Kitchen::newOrder");
+    ALLOC_SCOPE("Kitchen::newOrder");
+    return add(new_dish);
+}
+
+/**
+    * @param : A cuisine type, which may hold any value of its underlying type.
+    * @return : The type as the kitchen counts it: out-of-range values are
+    OTHER, as Dish::cuisineName prints them, so it is always a valid index
+    into the cuisine counts.
+*/
+static Dish::CuisineType countedCuisineType(Dish::CuisineType type) {
+    return type >= Dish::CuisineType::ITALIAN && type < Dish::CuisineType::OTHER ? type : Dish::CuisineType::OTHER;
+}
+
+/**
+    * @param : A price.
+    * @return : The price rounded to whole cents, as an unsigned key that
+    sorts in the same order as the signed number (NaN sorts last).
+*/
+static uint64_t priceCentsKey(double price) {
+    const double LIMIT = 9.2e18; // Just inside the range of int64_t
+    double cents = std::round(price * 100);
+    int64_t value = std::isnan(cents) ? INT64_MAX
+                    : cents >= LIMIT  ? INT64_MAX
+                    : cents <= -LIMIT ? INT64_MIN
+                                      : static_cast<int64_t>(cents);
+    return static_cast<uint64_t>(value) ^ (1ULL << 63);
+}
+
+/**
+    * @param : The sort keys and, in the same order, the slots they belong to.
+    * @param : The number of low bytes the keys use (at most 8).
+    * @post : Both are sorted by key, stably, with one counting pass per byte
+    of the keys. Bytes that are the same in every key are skipped.
+*/
+static void radixSortSlots(std::vector<uint64_t>& keys, std::vector<int>& slots, int key_bytes) {
+    size_t count = keys.size();
+    // Histograms of every byte position, all from one pass over the keys
+    uint32_t histograms[sizeof(uint64_t) * 256]; // 256 counts per byte position
+    std::fill(histograms, histograms + key_bytes * 256, 0);
+    for (uint64_t key : keys) {
+        for (int byte = 0; byte < key_bytes; byte++) {
+            histograms[byte * 256 + ((key >> (8 * byte)) & 0xFF)]++;
+        }
+    }
+
+    std::vector<uint64_t> sorted_keys(count);
+    std::vector<int> sorted_slots(count);
+    for (int byte = 0; byte < key_bytes; byte++) {
+        uint32_t* histogram = histograms + byte * 256;
+        if (histogram[(keys[0] >> (8 * byte)) & 0xFF] == count) {
+            continue; // Every key has the same byte here
+        }
+        uint32_t offset = 0;
+        for (int digit = 0; digit < 256; digit++) {
+            uint32_t digit_count = histogram[digit];
+            histogram[digit] = offset;
+            offset += digit_count;
+        }
+        for (size_t i = 0; i < count; i++) {
+            uint32_t position = histogram[(keys[i] >> (8 * byte)) & 0xFF]++;
+            sorted_keys[position] = keys[i];
+            sorted_slots[position] = slots[i];
+        }
+        keys.swap(sorted_keys);
+        slots.swap(sorted_slots);
+    }
+}
+
+/**
+    * @param : The key to sort by.
+    * @return : A view of the dishes in ascending, stable order of the key.
+*/
+Kitchen::SortedView Kitchen::sortedView(SortKey key) const {
+    TRACE_SCOPE_N("Kitchen::sortedView", getCurrentSize());
+    ALLOC_SCOPE("Kitchen::sortedView");
+    std::vector<uint64_t> keys(item_count_);
+    std::vector<int> slots(item_count_);
+    for (int i = 0; i < item_count_; i++) {
+        switch (key) {
+            // Flipping the sign bit makes the unsigned order match the signed one
+            case PREP_TIME: keys[i] = static_cast<uint32_t>(hot_[i].prep_time) ^ 0x80000000U; break;
+            case PRICE_CENTS: keys[i] = priceCentsKey(hot_[i].price); break;
+            case CUISINE: keys[i] = static_cast<uint32_t>(hot_[i].cuisine_type); break;
+        }
+        slots[i] = i;
+    }
+
+    if (item_count_ >= RADIX_SORT_MIN_SIZE) {
+        radixSortSlots(keys, slots, key == PRICE_CENTS ? 8 : key == PREP_TIME ? 4 : 1);
+    } else {
+        // Insertion sort: stable, and the fastest for a handful of dishes
+        for (int i = 1; i < item_count_; i++) {
+            uint64_t moving_key = keys[i];
+            int moving_slot = slots[i];
+            int j = i;
+            for (; j > 0 && keys[j - 1] > moving_key; j--) {
+                keys[j] = keys[j - 1];
+                slots[j] = slots[j - 1];
+            }
+            keys[j] = moving_key;
+            slots[j] = moving_slot;
+        }
+    }
+    return SortedView(items_, std::move(slots));
+}
+
+/**
+    * @param : The dishes of an existing order set, in order.
+    * @post : Adds the dishes exactly as calling newOrder on each of them in
+    turn would, and computes the statistics in one sweep.
+    * @return : Which inputs were added, which were duplicates and which did
+    not fit.
+*/
+BulkLoadResult Kitchen::bulkLoad(const std::vector<Dish>& dishes) {
+    TRACE_SCOPE_N("Kitchen::bulkLoad", dishes.size());
+    ALLOC_SCOPE("Kitchen::bulkLoad");
+    ChangeScope scope(*this);
+    BulkLoadResult result;
+    const int IN_KITCHEN = -1; // first_equal value of an input that is already in the kitchen
+    const int UNIQUE = -2;     // first_equal value of an input that equals nothing before it
+
+    // Hash every input once, then sort by hash so that equal dishes end up next to each other
+    std::vector<std::pair<uint64_t, size_t>> by_hash(dishes.size());
+    for (size_t i = 0; i < dishes.size(); i++) {
+        by_hash[i] = {dishes[i].hash(), i};
     }
+    std::sort(by_hash.begin(), by_hash.end());
 
-    // Add the dish to the kitchen using the ArrayBag::add method
-    bool added_successfully = add(new_dish);
+    // The kitchen's own hashes, sorted, so an input is only compared with a dish that shares its hash
+    std::vector<std::pair<uint64_t, int>> kitchen_hashes(item_count_);
+    for (int i = 0; i < item_count_; i++) {
+        kitchen_hashes[i] = {hot_[i].hash, i};
+    }
+    std::sort(kitchen_hashes.begin(), kitchen_hashes.end());
 
-    if (added_successfully) {
-        // Update the total preparation time
-        totalprep_time_ += new_dish.getPrepTime();
+    // first_equal[i]: the earliest input equal to input i, or IN_KITCHEN, or UNIQUE. Within a run of
+    // equal hashes the inputs are in input order, so the earliest equal one is found first.
+    std::vector<long long> first_equal(dishes.size(), UNIQUE);
+    std::vector<size_t> distinct; // The UNIQUE inputs of the current run; more than one only on a hash collision
+    for (size_t run = 0; run < by_hash.size();) {
+        uint64_t hash = by_hash[run].first;
+        auto in_kitchen = std::lower_bound(kitchen_hashes.begin(), kitchen_hashes.end(), std::make_pair(hash, 0));
+        distinct.clear();
+        for (; run < by_hash.size() && by_hash[run].first == hash; run++) {
+            size_t input = by_hash[run].second;
+            for (auto k = in_kitchen; k != kitchen_hashes.end() && k->first == hash; ++k) {
+                if (items_[k->second] == dishes[input]) {
+                    first_equal[input] = IN_KITCHEN;
+                    break;
+                }
+            }
+            for (size_t j = 0; j < distinct.size() && first_equal[input] == UNIQUE; j++) {
+                if (dishes[distinct[j]] == dishes[input]) {
+                    first_equal[input] = distinct[j];
+                }
+            }
+            if (first_equal[input] == UNIQUE) {
+                distinct.push_back(input);
+            }
+        }
+    }
 
-        // Check if the dish is elaborate and update the count
-        if (new_dish.getIngredients().size() >= 5 && new_dish.getPrepTime() >= 60) {
-            countelaborate++;
+    // Replay newOrder's decisions in input order. A later copy of an input that did not fit does
+    // not fit either; any other repeat is a duplicate.
+    std::vector<bool> added(dishes.size(), false);
+    for (size_t i = 0; i < dishes.size(); i++) {
+        long long first = first_equal[i];
+        if (first == IN_KITCHEN || (first >= 0 && added[first])) {
+            result.duplicates.push_back(i);
+        } else if (first == UNIQUE && item_count_ < DEFAULT_CAPACITY) {
+            appendDish(dishes[i], dishes[i].hash());
+            publishDish(KitchenEvent::DISH_ADDED, hot_[item_count_ - 1]);
+            added[i] = true;
+            result.added++;
+        } else {
+            result.rejected_full.push_back(i);
         }
     }
-    return added_successfully;
+    recomputeStatistics();
+    return result;
+}
+
+/**
+    * @param : A burst of orders and services, in order.
+    * @param : Set to what newOrder or serveDish would have returned for
+    each command.
+    * @post : Applies the commands as newOrder and serveDish would, updating
+    the statistics once at the end.
+    * @return : The number of commands that succeeded.
+*/
+size_t Kitchen::applyBatch(const std::vector<KitchenCommand>& commands, std::vector<bool>& results) {
+    TRACE_SCOPE_N("Kitchen::applyBatch", commands.size());
+    ALLOC_SCOPE("Kitchen::applyBatch");
+    ChangeScope scope(*this);
+    const size_t CHUNK = 64;         // Commands hashed before any of them is applied
+    const size_t PREFETCH_AHEAD = 8; // How far ahead of the hashing the dishes are prefetched
+
+    results.assign(commands.size(), false);
+    size_t succeeded = 0;
+    int prep_time_delta = 0;
+    int elaborate_delta = 0;
+    int cuisine_deltas[CUISINE_TYPE_COUNT] = {};
+    auto account = [&](const DishHot& hot, int direction) {
+        prep_time_delta += direction * hot.prep_time;
+        elaborate_delta += direction * (hot.ingredient_count >= 5 && hot.prep_time >= 60);
+        cuisine_deltas[hot.cuisine_type] += direction;
+    };
+
+    uint64_t hashes[CHUNK];
+    for (size_t start = 0; start < commands.size(); start += CHUNK) {
+        size_t end = std::min(start + CHUNK, commands.size());
+
+        // The hashes do not depend on the kitchen, so computing them back to back lets the loads of
+        // one dish overlap the hashing of another
+        for (size_t i = start; i < end; i++) {
+#if defined(__GNUC__)
+            if (i + PREFETCH_AHEAD < commands.size()) {
+                __builtin_prefetch(commands[i + PREFETCH_AHEAD].dish);
+            }
+#endif
+            hashes[i - start] = commands[i].dish->hash();
+        }
+
+        for (size_t i = start; i < end; i++) {
+            const Dish& dish = *commands[i].dish;
+            int index = findDish(dish, hashes[i - start]);
+            bool success = false;
+            if (commands[i].type == KitchenCommand::NEW_ORDER) {
+                if (index < 0 && item_count_ < DEFAULT_CAPACITY) {
+                    appendDish(dish, hashes[i - start]);
+                    account(hot_[item_count_ - 1], 1);
+                    publishDish(KitchenEvent::DISH_ADDED, hot_[item_count_ - 1]);
+                    success = true;
+                }
+            } else if (index >= 0) {
+                DishHot served = hot_[index];
+                account(served, -1);
+                removeSlot(index);
+                publishDish(KitchenEvent::DISH_SERVED, served);
+                success = true;
+            }
+            results[i] = success;
+            succeeded += success;
+        }
+    }
+
+    totalprep_time_ += prep_time_delta;
+    countelaborate += elaborate_delta;
+    for (int type = 0; type < CUISINE_TYPE_COUNT; type++) {
+        cuisine_counts_[type] += cuisine_deltas[type];
+    }
+    return succeeded;
 }
 
 /**
@@ -62,24 +443,11 @@ bool Kitchen::newOrder(const Dish& new_dish) {
     count.
 */
 bool Kitchen::serveDish(const Dish& dish) {
-    // Check if the dish is in the kitchen
-    if (!contains(dish)) {
-        return false;
-    }
-
-    // Remove the dish using the inherited remove() method
-    bool removed_successfully = remove(dish);
-
-    if (removed_successfully) {
-        // Update the total preparation time
-        totalprep_time_ -= dish.getPrepTime();
-
-        // Check and update elaborate count
-        if (dish.getIngredients().size() >= 5 && dish.getPrepTime() >= 60) {
-            countelaborate--;
-        }
-    }
-    return removed_successfully;
+    INSTRUMENT_CALL(SERVE_DISH);
+    KitchenLatency::Timer timer(KitchenLatency::SERVE_DISH);
+    TRACE_SCOPE("Kitchen::serveDish");
+    ALLOC_SCOPE("Kitchen::serveDish");
+    return remove(dish);
 }
 
 /**
@@ -87,6 +455,7 @@ bool Kitchen::serveDish(const Dish& dish) {
     currently in the kitchen.
 */
 int Kitchen::getPrepTimeSum() const {
+    INSTRUMENT_CALL(GET_PREP_TIME_SUM);
     return totalprep_time_;
 }
 
@@ -97,6 +466,7 @@ int Kitchen::getPrepTimeSum() const {
     rounded to the NEAREST integer.
 */
 int Kitchen::calculateAvgPrepTime() const {
+    INSTRUMENT_CALL(CALCULATE_AVG_PREP_TIME);
     int dish_count = getCurrentSize();
 
     // If no dishes are in the kitchen, return 0
@@ -113,6 +483,7 @@ int Kitchen::calculateAvgPrepTime() const {
     * @return : The integer count of the elaborate dishes in the kitchen.
 */
 int Kitchen::elaborateDishCount() const {
+    INSTRUMENT_CALL(ELABORATE_DISH_COUNT);
     return countelaborate;
 }
 
@@ -123,6 +494,7 @@ int Kitchen::elaborateDishCount() const {
     rounded up to 2 decimal places.
 */
 double Kitchen::calculateElaboratePercentage() const {
+    INSTRUMENT_CALL(CALCULATE_ELABORATE_PERCENTAGE);
     int dish_count = getCurrentSize();
 
     // If no dishes are in the kitchen, return 0
@@ -150,18 +522,23 @@ double Kitchen::calculateElaboratePercentage() const {
                     uppercase input will match.
 */
 int Kitchen::tallyCuisineTypes(const std::string& cuisine_type) const {
-    int count = 0;
-
-    // Iterate over all dishes in the kitchen
-    for (int i = 0; i < getCurrentSize(); i++) {
-        Dish dish = items_[i];
+    INSTRUMENT_CALL(TALLY_CUISINE_TYPES);
+    Dish::CuisineType type;
+    if (!parseCuisineType(cuisine_type, type)) {
+        return 0;
+    }
+    return cuisine_counts_[type];
+}
 
-        // Check if the dish's cuisine type matches the input string
-        if (dish.getCuisineType() == cuisine_type) {
-            count++;
-        }
+/**
+    * @param : A cuisine type.
+    * @return : The number of dishes in the kitchen of the given cuisine type.
+*/
+int Kitchen::cuisineCount(Dish::CuisineType cuisine_type) const {
+    if (cuisine_type < 0 || cuisine_type >= CUISINE_TYPE_COUNT) {
+        return 0;
     }
-    return count;
+    return cuisine_counts_[cuisine_type];
 }
 
 /**
@@ -175,29 +552,24 @@ int Kitchen::tallyCuisineTypes(const std::string& cuisine_type) const {
     * @return : The number of dishes removed from the kitchen.
 */
 int Kitchen::releaseDishesBelowPrepTime(int prep_time_threshold) {
+    INSTRUMENT_CALL(RELEASE_DISHES_BELOW_PREP_TIME);
+    KitchenLatency::Timer timer(KitchenLatency::RELEASE_DISHES_BELOW_PREP_TIME);
+    TRACE_SCOPE_N("Kitchen::releaseDishesBelowPrepTime", getCurrentSize());
+    ALLOC_SCOPE("Kitchen::releaseDishesBelowPrepTime");
     if (prep_time_threshold < 0) {
         return 0;  // Ignore negative input
     }
-
-    int removed_count = 0;
+    ChangeScope scope(*this);
 
     // If the threshold is 0, remove all dishes from the kitchen
+    int removed_count;
     if (prep_time_threshold == 0) {
-        removed_count = getCurrentSize();  // All dishes will be removed, so removed count equals the current size
-        clear();  // Use ArrayBag clear function to remove all items from the kitchen
-        return removed_count;
-    }
-
-    // Iterate through the kitchen starting from last element
-    for (int i = getCurrentSize() - 1; i >= 0; --i) {
-        // If the dish's prep time is less than the threshold, remove it
-        if (items_[i].getPrepTime() < prep_time_threshold) {
-            bool removed = remove(items_[i]);
-            if (removed) {
-                removed_count++;
-            }
-        }
+        removed_count = removeAll();
+    } else {
+        // Remove every dish whose prep time is less than the threshold, keeping the rest in order
+        removed_count = compactSlotsWhere([&](int slot) { return hot_[slot].prep_time < prep_time_threshold; });
     }
+    publishRelease(removed_count, -1);
     return removed_count;
 }
 
@@ -217,48 +589,31 @@ int Kitchen::releaseDishesBelowPrepTime(int prep_time_threshold) {
     types, do not remove any dishes.
 */
 int Kitchen::releaseDishesOfCuisineType(const std::string& cuisine_type) {
-    int removed_count = 0;
-
+    INSTRUMENT_CALL(RELEASE_DISHES_OF_CUISINE_TYPE);
+    KitchenLatency::Timer timer(KitchenLatency::RELEASE_DISHES_OF_CUISINE_TYPE);
+    TRACE_SCOPE_N("Kitchen::releaseDishesOfCuisineType", getCurrentSize());
+    ALLOC_SCOPE("Kitchen::releaseDishesOfCuisineType");
+    ChangeScope scope(*this);
     // If the input is "ALL", remove all dishes
     if (cuisine_type == "ALL") {
-        removed_count = getCurrentSize();  // All dishes will be removed, so removed count equals the current size
-        clear();  // Use ArrayBag clear function to remove all items from the kitchen
+        int removed_count = removeAll();
+        publishRelease(removed_count, -1);
         return removed_count;
     }
 
     // Match the string input to the corresponding CuisineType enum
     Dish::CuisineType type;
-    if (cuisine_type == "ITALIAN") {
-        type = Dish::CuisineType::ITALIAN;
-    } else if (cuisine_type == "MEXICAN") {
-        type = Dish::CuisineType::MEXICAN;
-    } else if (cuisine_type == "CHINESE") {
-        type = Dish::CuisineType::CHINESE;
-    } else if (cuisine_type == "INDIAN") {
-        type = Dish::CuisineType::INDIAN;
-    } else if (cuisine_type == "AMERICAN") {
-        type = Dish::CuisineType::AMERICAN;
-    } else if (cuisine_type == "FRENCH") {
-        type = Dish::CuisineType::FRENCH;
-    } else if (cuisine_type == "OTHER") {
-        type = Dish::CuisineType::OTHER;
-    } else {
+    if (!parseCuisineType(cuisine_type, type)) {
         return 0;
     }
 
-    // Iterate through the kitchen starting from the last element
-    for (int i = getCurrentSize() - 1; i >= 0; --i) {
-        // Convert the enum to a string for comparison
-        std::string current_cuisine = items_[i].getCuisineType();
-
-        // If the dish's cuisine type matches the input type, remove it
-        if (current_cuisine == cuisine_type) {
-            bool removed = remove(items_[i]);
-            if (removed) {
-                removed_count++;
-            }
-        }
+    if (cuisine_counts_[type] == 0) {
+        return 0;
     }
+
+    // Remove every dish whose cuisine type matches the input type
+    int removed_count = releaseSlotsWhere([&](int slot) { return hot_[slot].cuisine_type == type; });
+    publishRelease(removed_count, type);
     return removed_count;
 }
 
@@ -285,33 +640,577 @@ int Kitchen::releaseDishesOfCuisineType(const std::string& cuisine_type) {
     ELABORATE: 53.85%
 */
 void Kitchen::kitchenReport() const {
-    // Cuisine type counts
-    int italianCount = tallyCuisineTypes("ITALIAN");
-    int mexicanCount = tallyCuisineTypes("MEXICAN");
-    int chineseCount = tallyCuisineTypes("CHINESE");
-    int indianCount = tallyCuisineTypes("INDIAN");
-    int americanCount = tallyCuisineTypes("AMERICAN");
-    int frenchCount = tallyCuisineTypes("FRENCH");
-    int otherCount = tallyCuisineTypes("OTHER");
-
-    // Calculate the average preparation time
-    int avgPrepTime = calculateAvgPrepTime();
+    INSTRUMENT_CALL(KITCHEN_REPORT);
+    KitchenLatency::Timer timer(KitchenLatency::KITCHEN_REPORT);
+    TRACE_SCOPE_N("Kitchen::kitchenReport", getCurrentSize());
+    ALLOC_SCOPE("Kitchen::kitchenReport");
+    // Served from the cached report, which is rebuilt only if the kitchen changed since last time
+    std::cout << report().text;
+    // Leave std::cout formatting as the report has always left it
+    std::cout << std::fixed << std::setprecision(2) << std::flush;
+}
 
-    // Calculate the percentage of elaborate dishes
-    double elaboratePercentage = calculateElaboratePercentage();
-
-    // Output the cuisine type counts
-    std::cout << "ITALIAN: " << italianCount << std::endl;
-    std::cout << "MEXICAN: " << mexicanCount << std::endl;
-    std::cout << "CHINESE: " << chineseCount << std::endl;
-    std::cout << "INDIAN: " << indianCount << std::endl;
-    std::cout << "AMERICAN: " << americanCount << std::endl;
-    std::cout << "FRENCH: " << frenchCount << std::endl;
-    std::cout << "OTHER: " << otherCount << std::endl;
-
-    // Output the average preparation time
-    std::cout << "\nAVERAGE PREP TIME: " << avgPrepTime << std::endl;
-
-    // Output the percentage of elaborate dishes, rounded to two decimal places
-    std::cout << "ELABORATE: " << std::fixed << std::setprecision(2) << elaboratePercentage << "%" << std::endl;
+/**
+    * @return : A number that changes whenever the dishes of the kitchen
+    change.
+*/
+uint64_t Kitchen::version() const {
+    return version_;
+}
+
+/**
+    * @return : The report of the current dishes, rebuilt only if the version
+    changed since the last call. Callers that find it stale rebuild it one at
+    a time.
+*/
+const KitchenReport& Kitchen::report() const {
+    // Concurrent const callers may all find the cache stale; the first to take the lock rebuilds it
+    // and the rest find it current
+    if (report_version_.load(std::memory_order_acquire) == version_) {
+        return report_;
+    }
+    std::lock_guard<std::mutex> lock(report_mutex_);
+    if (report_.version == version_) {
+        return report_;
+    }
+    bool first_build = report_.version == 0;
+
+    // Format again only the lines whose number moved
+    for (int type = 0; type < CUISINE_TYPE_COUNT; type++) {
+        if (first_build || report_.cuisine_counts[type] != cuisine_counts_[type]) {
+            report_.cuisine_counts[type] = cuisine_counts_[type];
+            report_.lines[type] = std::string(Dish::cuisineName(static_cast<Dish::CuisineType>(type))) + ": " +
+                                  std::to_string(cuisine_counts_[type]);
+            report_line_versions_[type] = version_;
+        }
+    }
+    int avg_prep_time = calculateAvgPrepTime();
+    if (first_build || report_.avg_prep_time != avg_prep_time) {
+        report_.avg_prep_time = avg_prep_time;
+        report_.lines[KitchenReport::AVG_PREP_TIME_LINE] = "AVERAGE PREP TIME: " + std::to_string(avg_prep_time);
+        report_line_versions_[KitchenReport::AVG_PREP_TIME_LINE] = version_;
+    }
+    double elaborate_percentage = calculateElaboratePercentage();
+    if (first_build || report_.elaborate_percentage != elaborate_percentage) {
+        char digits[32];
+        char* end = std::to_chars(digits, digits + sizeof(digits), elaborate_percentage, std::chars_format::fixed, 2).ptr;
+        report_.elaborate_percentage = elaborate_percentage;
+        report_.lines[KitchenReport::ELABORATE_LINE] = "ELABORATE: " + std::string(digits, end) + "%";
+        report_line_versions_[KitchenReport::ELABORATE_LINE] = version_;
+    }
+
+    // Reassemble the text in kitchenReport's layout, reusing the string's capacity
+    report_.text.clear();
+    for (int line = 0; line < KitchenReport::LINE_COUNT; line++) {
+        if (line == KitchenReport::AVG_PREP_TIME_LINE) {
+            report_.text += '\n';
+        }
+        report_.text += report_.lines[line];
+        report_.text += '\n';
+    }
+    report_.version = version_;
+    report_version_.store(version_, std::memory_order_release);
+    return report_;
+}
+
+/**
+    * @param : A version of this kitchen.
+    * @return : The lines of the current report that changed after that
+    version, in report order.
+*/
+std::vector<KitchenReportLine> Kitchen::reportChangesSince(uint64_t version) const {
+    const KitchenReport& current = report();
+    std::vector<KitchenReportLine> changes;
+    for (int line = 0; line < KitchenReport::LINE_COUNT; line++) {
+        if (report_line_versions_[line] > version) {
+            changes.push_back({line, current.lines[line]});
+        }
+    }
+    return changes;
+}
+
+/**
+    * @param : The queue to publish change events to, or nullptr.
+    * @post : Changes are published to the queue from now on.
+*/
+void Kitchen::setEventQueue(KitchenEventQueue* queue) {
+    events_ = queue;
+}
+
+/**
+    * @param : The most memory, in bytes, the journal's entries may hold.
+    * @post : Every later change is recorded as one undo entry.
+*/
+void Kitchen::enableUndo(size_t budget_bytes) {
+    journal_.reset(new Journal(budget_bytes));
+}
+
+/**
+    * @post : Stops recording and discards the journal.
+*/
+void Kitchen::disableUndo() {
+    journal_.reset();
+}
+
+/**
+    * @post : Reverts the most recent change in the journal.
+    * @return : True if there was a change to undo.
+*/
+bool Kitchen::undo() {
+    if (journal_ == nullptr || journal_->undo.empty()) {
+        return false;
+    }
+    Journal::Entry entry = std::move(journal_->undo.back());
+    journal_->undo.pop_back();
+    journal_->bytes -= entry.bytes;
+
+    int taken_out = 0;
+    for (auto step = entry.steps.rbegin(); step != entry.steps.rend(); ++step) {
+        if (step->kind == Journal::Step::APPEND) {
+            // The appended dish is last again, as every later step has been undone; keep it for redo
+            if (step->first_dish < 0) {
+                step->first_dish = Journal::keepDish(entry, items_[step->slot], hot_[step->slot].hash);
+            }
+            removeSlot(step->slot);
+            taken_out++;
+        } else if (step->kind == Journal::Step::REMOVE_SLOT) {
+            // The removal moved the last dish into the slot; append the dish and swap them back
+            appendDish(entry.dishes[step->first_dish], entry.hashes[step->first_dish]);
+            int last = item_count_ - 1;
+            if (step->slot != last) {
+                items_[step->slot].swap(items_[last]);
+                std::swap(hot_[step->slot], hot_[last]);
+            }
+            publishDish(KitchenEvent::DISH_ADDED, hot_[step->slot]);
+        } else if (step->kind == Journal::Step::REMOVE_SHIFTING) {
+            // The removal shifted the later dishes down; append the dish and rotate it back into its slot
+            appendDish(entry.dishes[step->first_dish], entry.hashes[step->first_dish]);
+            for (int i = item_count_ - 1; i > step->slot; i--) {
+                items_[i].swap(items_[i - 1]);
+                std::swap(hot_[i], hot_[i - 1]);
+            }
+            publishDish(KitchenEvent::DISH_ADDED, hot_[step->slot]);
+        } else {
+            for (int i = step->first_dish; i < step->first_dish + step->dish_count; i++) {
+                appendDish(entry.dishes[i], entry.hashes[i]);
+                publishDish(KitchenEvent::DISH_ADDED, hot_[item_count_ - 1]);
+            }
+        }
+    }
+    totalprep_time_ -= entry.prep_time_delta;
+    countelaborate -= entry.elaborate_delta;
+    for (int type = 0; type < CUISINE_TYPE_COUNT; type++) {
+        cuisine_counts_[type] -= entry.cuisine_deltas[type];
+    }
+    publishRelease(taken_out, -1);
+
+    entry.bytes = Journal::entryBytes(entry);
+    journal_->bytes += entry.bytes;
+    journal_->redo.push_back(std::move(entry));
+    journal_->enforceBudget();
+    return true;
+}
+
+/**
+    * @post : Applies again the most recently undone change.
+    * @return : True if there was a change to redo.
+*/
+bool Kitchen::redo() {
+    if (journal_ == nullptr || journal_->redo.empty()) {
+        return false;
+    }
+    Journal::Entry entry = std::move(journal_->redo.back());
+    journal_->redo.pop_back();
+
+    int taken_out = 0;
+    for (const Journal::Step& step : entry.steps) {
+        if (step.kind == Journal::Step::APPEND) {
+            appendDish(entry.dishes[step.first_dish], entry.hashes[step.first_dish]);
+            publishDish(KitchenEvent::DISH_ADDED, hot_[item_count_ - 1]);
+        } else if (step.kind == Journal::Step::REMOVE_SLOT) {
+            removeSlot(step.slot);
+            taken_out++;
+        } else if (step.kind == Journal::Step::REMOVE_SHIFTING) {
+            removeSlotShifting(step.slot);
+            taken_out++;
+        } else {
+            taken_out += item_count_;
+            ArrayBag<Dish>::clear();
+            resetSlots();
+            version_++;
+        }
+    }
+    totalprep_time_ += entry.prep_time_delta;
+    countelaborate += entry.elaborate_delta;
+    for (int type = 0; type < CUISINE_TYPE_COUNT; type++) {
+        cuisine_counts_[type] += entry.cuisine_deltas[type];
+    }
+    publishRelease(taken_out, -1);
+
+    journal_->undo.push_back(std::move(entry));
+    return true;
+}
+
+/**
+    * @return : The number of changes undo can step through.
+*/
+size_t Kitchen::undoDepth() const {
+    return journal_ == nullptr ? 0 : journal_->undo.size();
+}
+
+/**
+    * @return : The number of changes redo can step through.
+*/
+size_t Kitchen::redoDepth() const {
+    return journal_ == nullptr ? 0 : journal_->redo.size();
+}
+
+/**
+    * @return : The memory, in bytes, the journal's entries hold.
+*/
+size_t Kitchen::undoBytes() const {
+    return journal_ == nullptr ? 0 : journal_->bytes;
+}
+
+/**
+    * @post : Opens the undo entry of a change, remembering the counters, if
+    this is the outermost scope.
+*/
+void Kitchen::beginChange() {
+    if (journal_->depth++ == 0) {
+        journal_->prep_time_before = totalprep_time_;
+        journal_->elaborate_before = countelaborate;
+        std::copy(cuisine_counts_, cuisine_counts_ + CUISINE_TYPE_COUNT, journal_->cuisine_before);
+    }
+}
+
+/**
+    * @post : Closing the outermost scope of a change that did something
+    stores its entry, with the counter deltas, and discards the redo
+    entries.
+*/
+void Kitchen::endChange() {
+    Journal& journal = *journal_;
+    if (--journal.depth > 0 || journal.open.steps.empty()) {
+        return;
+    }
+    Journal::Entry& entry = journal.open;
+    entry.prep_time_delta = totalprep_time_ - journal.prep_time_before;
+    entry.elaborate_delta = countelaborate - journal.elaborate_before;
+    for (int type = 0; type < CUISINE_TYPE_COUNT; type++) {
+        entry.cuisine_deltas[type] = cuisine_counts_[type] - journal.cuisine_before[type];
+    }
+    entry.bytes = Journal::entryBytes(entry);
+
+    for (const Journal::Entry& undone : journal.redo) {
+        journal.bytes -= undone.bytes;
+    }
+    journal.redo.clear();
+    journal.bytes += entry.bytes;
+    journal.undo.push_back(std::move(entry));
+    journal.open = Journal::Entry();
+    journal.enforceBudget();
+}
+
+/**
+    * @param : The slot just appended.
+    * @post : Records the append; the dish itself is only copied if the
+    change is undone.
+*/
+void Kitchen::recordAppend(int index) {
+    if (journal_->depth > 0) {
+        journal_->open.steps.push_back({Journal::Step::APPEND, index, -1, 0});
+    }
+}
+
+/**
+    * @param : The slot about to be removed.
+    * @post : Records the removal with a copy of the dish.
+*/
+void Kitchen::recordRemove(int index) {
+    if (journal_->depth > 0) {
+        Journal::Entry& entry = journal_->open;
+        int32_t dish = Journal::keepDish(entry, items_[index], hot_[index].hash);
+        entry.steps.push_back({Journal::Step::REMOVE_SLOT, index, dish, 1});
+    }
+}
+
+/**
+    * @param : The slot a dish is removed from when the removals of a
+    compaction are taken one at a time in slot order, and the slot it is in
+    now.
+    * @post : Records the removal, with a copy of the dish.
+*/
+void Kitchen::recordRemoveShifting(int slot, int index) {
+    if (journal_->depth > 0) {
+        Journal::Entry& entry = journal_->open;
+        int32_t dish = Journal::keepDish(entry, items_[index], hot_[index].hash);
+        entry.steps.push_back({Journal::Step::REMOVE_SHIFTING, slot, dish, 1});
+    }
+}
+
+/**
+    * @post : Records the removal of every dish with copies of them, in
+    slot order.
+*/
+void Kitchen::recordRemoveAll() {
+    if (journal_->depth > 0 && item_count_ > 0) {
+        Journal::Entry& entry = journal_->open;
+        int32_t first = static_cast<int32_t>(entry.dishes.size());
+        for (int i = 0; i < item_count_; i++) {
+            Journal::keepDish(entry, items_[i], hot_[i].hash);
+        }
+        entry.steps.push_back({Journal::Step::REMOVE_ALL, 0, first, item_count_});
+    }
+}
+
+/**
+    * @param : The stream to write to.
+    * @post : Writes every dish, followed by an empty line, to the stream in a
+    single write.
+    * @return : The number of characters written.
+*/
+size_t Kitchen::renderAll(std::ostream& out) const {
+    TRACE_SCOPE_N("Kitchen::renderAll", getCurrentSize());
+    ALLOC_SCOPE("Kitchen::renderAll");
+    const size_t DISH_ESTIMATE = 256; // Room reserved per dish; longer dishes are formatted again
+
+    std::string buffer;
+    buffer.reserve(item_count_ * (DISH_ESTIMATE + 1));
+    for (int i = 0; i < item_count_; i++) {
+        size_t offset = buffer.size();
+        buffer.resize(offset + DISH_ESTIMATE);
+        size_t length = items_[i].renderTo(&buffer[offset], DISH_ESTIMATE);
+        if (length > DISH_ESTIMATE) {
+            buffer.resize(offset + length);
+            items_[i].renderTo(&buffer[offset], length);
+        }
+        buffer.resize(offset + length);
+        buffer += '\n';
+    }
+    out.write(buffer.data(), buffer.size());
+    return buffer.size();
+}
+
+/**
+    * @post : The prep time sum, elaborate count and cuisine counts are
+    recomputed from hot_ in one sweep.
+*/
+void Kitchen::recomputeStatistics() {
+    totalprep_time_ = 0;
+    countelaborate = 0;
+    std::fill(cuisine_counts_, cuisine_counts_ + CUISINE_TYPE_COUNT, 0);
+    for (int i = 0; i < item_count_; i++) {
+        totalprep_time_ += hot_[i].prep_time;
+        countelaborate += hot_[i].ingredient_count >= 5 && hot_[i].prep_time >= 60;
+        cuisine_counts_[hot_[i].cuisine_type]++;
+    }
+}
+
+/**
+    * @param : A dish entering (direction 1) or leaving (direction -1) the kitchen.
+    * @post : The prep time sum, elaborate count and cuisine counts include
+    (or no longer include) the dish.
+*/
+void Kitchen::updateStatistics(const Dish& dish, int direction) {
+    totalprep_time_ += direction * dish.getPrepTime();
+
+    // A dish is elaborate if it has at least 5 ingredients and takes at least 60 minutes
+    if (dish.getIngredientCount() >= 5 && dish.getPrepTime() >= 60) {
+        countelaborate += direction;
+    }
+    cuisine_counts_[countedCuisineType(dish.getCuisineTypeEnum())] += direction;
+}
+
+/**
+    * @param : The index of a dish in the kitchen.
+    * @post : Removes the dish by moving the last dish into its slot, and
+    updates the statistics. The removed dish is retired, not destroyed.
+*/
+void Kitchen::removeAt(int index) {
+    updateStatistics(items_[index], -1);
+    removeSlot(index);
+}
+
+/**
+    * @param : The index of a dish in the kitchen.
+    * @post : Removes the dish by moving the last dish into its slot, without
+    updating the statistics.
+*/
+void Kitchen::removeSlot(int index) {
+    if (journal_ != nullptr) {
+        recordRemove(index);
+    }
+    version_++;
+    item_count_--;
+    if (index != item_count_) {
+        // Swap rather than copy: the retired dish, with its allocated buffers, becomes the top of
+        // the pool of retired dishes past item_count_, and the next newOrder assigns into it
+        items_[index].swap(items_[item_count_]);
+        hot_[index] = hot_[item_count_];
+        INSTRUMENT_COUNT(elements_shifted);
+    }
+}
+
+/**
+    * @param : The index of a dish in the kitchen.
+    * @post : Removes the dish by shifting every later dish down one slot,
+    without updating the statistics. The removed dish ends up on top of the
+    pool of retired dishes.
+*/
+void Kitchen::removeSlotShifting(int index) {
+    version_++;
+    item_count_--;
+    for (int i = index; i < item_count_; i++) {
+        shiftSlot(i + 1, i);
+    }
+}
+
+/**
+    * @param : A slot holding a dish to keep, and the lower slot it moves to.
+    * @post : Swaps the two dishes, so the dish in `to` (removed) keeps its
+    buffers for the pool, and copies the hot fields down.
+*/
+void Kitchen::shiftSlot(int from, int to) {
+    items_[to].swap(items_[from]);
+    hot_[to] = hot_[from];
+    INSTRUMENT_COUNT(elements_shifted);
+}
+
+/**
+    * @post : Removes every dish and resets the statistics.
+    * @return : The number of dishes removed.
+*/
+int Kitchen::removeAll() {
+    int removed_count = getCurrentSize();
+    if (journal_ != nullptr) {
+        recordRemoveAll();
+    }
+    version_++;
+    ArrayBag<Dish>::clear();
+    resetSlots();
+    totalprep_time_ = 0;
+    countelaborate = 0;
+    for (int i = 0; i < CUISINE_TYPE_COUNT; i++) {
+        cuisine_counts_[i] = 0;
+    }
+    return removed_count;
+}
+
+/**
+    * @param : A dish.
+    * @post : Adds the dish unless it is already in the kitchen or the kitchen
+    is full, keeping the statistics up to date.
+    * @return : True if the dish was added, false otherwise.
+*/
+bool Kitchen::add(const Dish& new_entry) {
+    ChangeScope scope(*this);
+    uint64_t hash = new_entry.hash();
+    if (findDish(new_entry, hash) >= 0 || item_count_ >= DEFAULT_CAPACITY) {
+        return false;
+    }
+
+    appendDish(new_entry, hash);
+    updateStatistics(new_entry, 1);
+    publishDish(KitchenEvent::DISH_ADDED, hot_[item_count_ - 1]);
+    return true;
+}
+
+/**
+    * @param : A dish that is not in the kitchen, and its hash.
+    * @post : Stores the dish in the next free slot and its hot fields in
+    hot_. Does not update the statistics.
+*/
+void Kitchen::appendDish(const Dish& dish, uint64_t hash) {
+    // Copy-assign into items_[item_count_]: the most recently retired dish, whose name and
+    // ingredient capacity the assignment reuses
+    items_[item_count_] = dish;
+    hot_[item_count_] = {hash, dish.getPrice(), dish.getPrepTime(), static_cast<uint32_t>(dish.getIngredientCount()),
+                         countedCuisineType(dish.getCuisineTypeEnum())};
+    item_count_++;
+    version_++;
+    if (journal_ != nullptr) {
+        recordAppend(item_count_ - 1);
+    }
+}
+
+/**
+    * @param : A dish.
+    * @post : Removes the dish if it is in the kitchen, keeping the statistics
+    up to date.
+    * @return : True if the dish was removed, false otherwise.
+*/
+bool Kitchen::remove(const Dish& an_entry) {
+    ChangeScope scope(*this);
+    int index = findDish(an_entry, an_entry.hash());
+    if (index < 0) {
+        return false;
+    }
+    DishHot served = hot_[index];
+    removeAt(index);
+    publishDish(KitchenEvent::DISH_SERVED, served);
+    return true;
+}
+
+/**
+    * @param : A dish.
+    * @return : True if the dish is in the kitchen, false otherwise.
+*/
+bool Kitchen::contains(const Dish& an_entry) const {
+    return findDish(an_entry, an_entry.hash()) >= 0;
+}
+
+/**
+    * @param : A dish.
+    * @return : The number of times the dish is in the kitchen (0 or 1).
+*/
+int Kitchen::getFrequencyOf(const Dish& an_entry) const {
+    return contains(an_entry) ? 1 : 0;
+}
+
+/**
+    * @param : A dish and its hash.
+    * @return : The index of the dish in the kitchen, or -1 if it is not in
+    the kitchen.
+*/
+int Kitchen::findDish(const Dish& dish, uint64_t hash) const {
+    for (int i = 0; i < item_count_; i++) {
+        INSTRUMENT_COUNT(slots_scanned);
+        // Only a matching hash makes it worth touching the cold Dish
+        if (hot_[i].hash == hash && items_[i] == dish) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+    * @post : Every slot holds a default Dish bound to the arena, and the
+    arena has handed all of its memory back at once.
+*/
+void Kitchen::resetSlots() {
+    // Every string of every slot was allocated from arena_ (assignment and swaps between slots
+    // never change a slot's allocator), so instead of running each destructor to free them one
+    // by one, the slots are re-created over the old objects and the arena releases everything.
+    // Nothing depends on the skipped destructors, which would only have deallocated.
+    for (int i = 0; i < DEFAULT_CAPACITY; i++) {
+        new (&items_[i]) Dish(Dish::allocator_type(&arena_));
+    }
+    arena_.release();
+    chunks_.release();
+}
+
+/**
+    * @param : A cuisine type in string form and the enum to store it in.
+    * @return : True if the string is one of the cuisine type names, false
+    otherwise.
+*/
+bool Kitchen::parseCuisineType(const std::string& cuisine_type, Dish::CuisineType& type) {
+    for (int i = 0; i < CUISINE_TYPE_COUNT; i++) {
+        if (cuisine_type == Dish::cuisineName(static_cast<Dish::CuisineType>(i))) {
+            type = static_cast<Dish::CuisineType>(i);
+            return true;
+        }
+    }
+    return false;
 }
@@ -5,6 +5,50 @@
  * The Kitchen class includes attributes to represent the sum of prep times and the number of elaborate dishes.
  * It provides a constructor and several unique methods for kitchen calculations and related Dish functions.
  *
+ * Every Kitchen owns a memory arena. Its dish slots are allocator-aware Dish objects bound to the
+ * arena, so the names and ingredients of one kitchen's dishes are packed together instead of being
+ * scattered across the global heap, and emptying the kitchen hands the whole arena back at once
+ * instead of freeing each dish's strings.
+ *
+ * The slots past the last dish form a last-in, first-out pool of retired dishes. serveDish and
+ * the release functions swap a removed dish to the top of the pool instead of destroying it, and
+ * newOrder copy-assigns the new dish over the top of the pool, so order churn reuses the name and
+ * ingredient capacity of recently served dishes instead of allocating. serveDish and most releases
+ * fill each gap with the last dish, which moves one dish per removal. releaseDishesBelowPrepTime,
+ * which KitchenFleet runs across a fleet whose order it keeps, instead compacts the kitchen stably
+ * in one pass, so the dishes it keeps stay in order at the cost of moving every dish after the
+ * first gap.
+ *
+ * Lookups and release scans do not walk the Dish objects. A side table, hot_, keeps for every slot
+ * the fields those loops read (a hash of the fields operator== compares, prep time, price, cuisine
+ * type, ingredient count) in 32 bytes, two entries per cache line. The Dish in the same slot is the
+ * cold record, touched only when a hash matches or a dish is copied. Kitchen's add, remove, clear,
+ * contains and getFrequencyOf hide ArrayBag's so that they keep the table in step. ArrayBag's
+ * functions are not virtual, though: called through an ArrayBag<Dish>& or ArrayBag<Dish>* that
+ * refers to a Kitchen, add, remove and clear are ArrayBag's own, which change the dishes without
+ * updating hot_, the maintained counters, the version or the undo journal. Change a Kitchen only
+ * through the Kitchen type.
+ *
+ * The dishes can be read in place through ArrayBag's const begin(), end() and data(); they are
+ * contiguous, so range-for, <algorithm> and (from C++20) std::span work on a Kitchen directly.
+ *
+ * Every change to the dishes bumps a version counter. report() keeps the formatted kitchenReport
+ * and its numbers cached against that version, so repeated requests for an unchanged kitchen cost
+ * a comparison; after a change, only the lines whose maintained counter moved are formatted again.
+ * Each line remembers the version at which it last changed, which is what reportChangesSince uses.
+ * The cache is rebuilt under a mutex, so the const report functions may be called from several
+ * threads at once, as long as none of them changes the kitchen meanwhile.
+ *
+ * With a KitchenEventQueue attached, every added or served dish and every bulk release is also
+ * published to the queue as a KitchenEvent (see KitchenEvents.hpp). Without one, the cost is a
+ * null check.
+ *
+ * enableUndo turns on an undo journal. Each public change becomes one entry of compact deltas: the
+ * slots it appended to, copies of the dishes it removed (with the slot each came from), and the
+ * change to the counters. Undo and redo replay an entry's steps backwards or forwards, so they cost
+ * time in proportion to the change, not to the kitchen. The entries are held to a memory budget by
+ * dropping the oldest.
+ *
  * @date 10/04/2024
  * @author Mitchell Lipyansky
  */
@@ -14,15 +58,203 @@
 
 #include "ArrayBag.hpp"
 #include "Dish.hpp"
+#include "KitchenEvents.hpp"
+#include <atomic>
+#include <cstdint>
+#include <iosfwd>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Owns the memory arena of a Kitchen. It is a separate base class, listed before ArrayBag<Dish>,
+ * so the arena is constructed before and destroyed after the dishes that allocate from it.
+ *
+ * The arena is a pool (blocks freed by a dish are reused by the next one, so churn does not grow
+ * it) that carves its blocks out of a monotonic buffer starting inside the Kitchen object, so a
+ * small kitchen never touches the global heap.
+ */
+class KitchenArena {
+protected:
+    static const size_t INITIAL_BYTES = 8192; // Arena memory stored inline in the Kitchen
+
+    KitchenArena() : chunks_(initial_, INITIAL_BYTES), arena_(&chunks_) {}
+
+    alignas(std::max_align_t) unsigned char initial_[INITIAL_BYTES];
+    std::pmr::monotonic_buffer_resource chunks_; // Hands out pool chunks, first from initial_
+    std::pmr::unsynchronized_pool_resource arena_;
+};
 
-class Kitchen : public ArrayBag<Dish> {
+/**
+ * What Kitchen::bulkLoad did with its input. Every input index is in exactly one of the lists or
+ * counted in `added`.
+ */
+struct BulkLoadResult {
+    int added = 0;                     // Dishes added to the kitchen
+    std::vector<size_t> duplicates;    // Inputs already in the kitchen, or equal to an earlier input
+    std::vector<size_t> rejected_full; // Inputs that were new but did not fit in the kitchen
+};
+
+/**
+ * One order or service of a batch passed to Kitchen::applyBatch.
+ */
+struct KitchenCommand {
+    enum Type : uint8_t { NEW_ORDER, SERVE_DISH };
+    Type type;
+    const Dish* dish; // Must stay valid until applyBatch returns
+};
+
+/**
+ * The report of Kitchen::kitchenReport, both as numbers and as the lines it prints.
+ */
+struct KitchenReport {
+    static const int CUISINE_TYPE_COUNT = Dish::CuisineType::OTHER + 1;
+    // One line per cuisine type, in CuisineType order, then these two
+    static const int AVG_PREP_TIME_LINE = CUISINE_TYPE_COUNT;
+    static const int ELABORATE_LINE = CUISINE_TYPE_COUNT + 1;
+    static const int LINE_COUNT = CUISINE_TYPE_COUNT + 2;
+
+    uint64_t version = 0; // The Kitchen::version() the report describes; 0 until first built
+    int cuisine_counts[CUISINE_TYPE_COUNT] = {};
+    int avg_prep_time = 0;
+    double elaborate_percentage = 0;
+    std::string lines[LINE_COUNT]; // Without the newline, e.g. "ITALIAN: 2" or "ELABORATE: 53.85%"
+    std::string text;              // Exactly what kitchenReport prints
+};
+
+/**
+ * A line of the report returned by Kitchen::reportChangesSince.
+ */
+struct KitchenReportLine {
+    int index;        // Index into KitchenReport::lines
+    std::string text;
+};
+
+class Kitchen : private KitchenArena, public ArrayBag<Dish> {
 public:
+    /**
+     * The keys sortedView can order the dishes by.
+     */
+    enum SortKey { PREP_TIME, PRICE_CENTS, CUISINE };
+
+    /**
+     * The dishes of a kitchen in sorted order, as a permutation of slot indices. No Dish is copied
+     * or moved. Any change to the kitchen invalidates the view.
+     */
+    class SortedView {
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = Dish;
+            using difference_type = std::ptrdiff_t;
+            using pointer = const Dish*;
+            using reference = const Dish&;
+
+            inline iterator(const SortedView* view, size_t index);
+            inline const Dish& operator*() const;
+            inline iterator& operator++();
+            inline iterator operator++(int);
+            inline bool operator==(const iterator& other) const;
+            inline bool operator!=(const iterator& other) const;
+
+        private:
+            const SortedView* view_;
+            size_t index_;
+        };
+
+        /**
+         * @param dishes The kitchen's slots.
+         * @param order The slot indices in sorted order.
+         */
+        inline SortedView(const Dish* dishes, std::vector<int> order);
+        inline iterator begin() const;
+        inline iterator end() const;
+        inline size_t size() const;
+
+        /**
+         * @param index A position less than size().
+         * @return The dish at that position of the sorted order.
+         */
+        inline const Dish& operator[](size_t index) const;
+
+        /**
+         * @return The slot indices in sorted order.
+         */
+        inline const std::vector<int>& order() const;
+
+    private:
+        const Dish* dishes_;
+        std::vector<int> order_;
+    };
+
     /**
     * Default constructor.
-    * Default-initializes all private members.
+    * Default-initializes all private members and binds every dish slot
+    to the kitchen's arena.
     */
     Kitchen();
 
+    /**
+    * Copy constructor.
+    * @param : The kitchen to copy. The copy has its own arena; the dishes are
+    copied into it.
+    */
+    Kitchen(const Kitchen& other);
+
+    /**
+    * Copy assignment operator (also used for moves, as the dishes cannot
+    leave the arena they were allocated from).
+    * @param : The kitchen to copy.
+    * @post : Releases this kitchen's arena, then copies the dishes of `other`
+    into it.
+    */
+    Kitchen& operator=(const Kitchen& other);
+
+    /**
+    * Destructor.
+    * @post : Releases the arena in one step.
+    */
+    ~Kitchen();
+
+    /**
+    * @post : Removes every dish, resets the statistics and releases the
+    arena in one step.
+    */
+    void clear();
+
+    /**
+    * @param : A dish.
+    * @post : Adds the dish unless it is already in the kitchen or the kitchen
+    is full, keeping the statistics up to date. newOrder without the timing.
+    * @return : True if the dish was added, false otherwise.
+    */
+    bool add(const Dish& new_entry);
+
+    /**
+    * @param : A dish.
+    * @post : Removes the dish if it is in the kitchen, keeping the statistics
+    up to date. serveDish without the timing.
+    * @return : True if the dish was removed, false otherwise.
+    */
+    bool remove(const Dish& an_entry);
+
+    /**
+    * @param : A dish.
+    * @return : True if the dish is in the kitchen, false otherwise.
+    */
+    bool contains(const Dish& an_entry) const;
+
+    /**
+    * @param : A dish.
+    * @return : The number of times the dish is in the kitchen (0 or 1).
+    */
+    int getFrequencyOf(const Dish& an_entry) const;
+
     /**
     * @param : A reference to a `Dish` being added to the kitchen.
     * @post : If the given `Dish` is not already in the kitchen, adds the
@@ -35,6 +267,29 @@ public:
     */
     bool newOrder(const Dish& new_dish);
 
+    /**
+    * @param : The dishes of an existing order set, in order.
+    * @post : Adds the dishes exactly as calling newOrder on each of them in
+    turn would, but hashes every input once, finds duplicates by sorting
+    the hashes instead of scanning the kitchen per dish, and computes the
+    statistics in one sweep at the end.
+    * @return : Which inputs were added, which were duplicates and which did
+    not fit.
+    */
+    BulkLoadResult bulkLoad(const std::vector<Dish>& dishes);
+
+    /**
+    * @param : A burst of orders and services, in order.
+    * @param : Set to one entry per command: what newOrder or serveDish
+    would have returned for it.
+    * @post : Applies the commands exactly as calling newOrder and serveDish
+    in turn would. The dishes are hashed a chunk at a time, with the
+    dishes further ahead prefetched, and the statistics are updated once
+    at the end with the summed changes of the whole batch.
+    * @return : The number of commands that succeeded.
+    */
+    size_t applyBatch(const std::vector<KitchenCommand>& commands, std::vector<bool>& results);
+
     /**
     * @param : A reference to a `Dish` leaving the kitchen.
     * @return : Returns true if a dish was successfully removed from the
@@ -87,6 +342,14 @@ public:
     */
     int tallyCuisineTypes(const std::string& cuisine_type) const;
 
+    /**
+    * @param : A cuisine type.
+    * @return : The number of dishes in the kitchen of the given cuisine type.
+             Like the other statistics this is maintained on every change, so
+             reading it does not scan the dishes.
+    */
+    int cuisineCount(Dish::CuisineType cuisine_type) const;
+
     /**
     * @param : A reference to an integer representing the preparation time
     threshold of the dishes to be removed from
@@ -94,7 +357,7 @@ public:
     * @post : Removes all dishes from the kitchen whose preparation time is
     less than the given time.
            If no time is given, removes all dishes from the kitchen. Ignore
-    negative input.
+    negative input. The dishes kept stay in order.
     * @return : The number of dishes removed from the kitchen.
     */
     int releaseDishesBelowPrepTime(int prep_time_threshold = 0);
@@ -116,6 +379,40 @@ public:
     */
     int releaseDishesOfCuisineType(const std::string& cuisine_type = "ALL");
 
+    /**
+    * @param : A predicate callable as `bool(const Dish&)`, e.g. "MEXICAN and
+    over $15" or "contains shellfish".
+    * @post : Removes every dish for which the predicate is true in a single
+    pass, filling each gap with the last dish as serveDish does. The
+    removed dishes are retired, not destroyed; the statistics are kept up
+    to date.
+    * @return : The number of dishes removed from the kitchen.
+    */
+    template <typename Predicate>
+    int releaseWhere(Predicate predicate);
+
+    /**
+    * @param : The kitchen to move dishes to, e.g. an overflow kitchen.
+    * @param : A predicate callable as `bool(const Dish&)`.
+    * @post : Moves every dish for which the predicate is true to the other
+    kitchen, in a single pass over this one. A dish stays here if the other
+    kitchen already has it or is full. The statistics of both kitchens are
+    kept up to date. Does nothing if the other kitchen is this one.
+    * @return : The number of dishes moved.
+    */
+    template <typename Predicate>
+    int partitionInto(Kitchen& other, Predicate predicate);
+
+    /**
+    * @param : The key to sort by: prep time, price rounded to whole cents,
+    or cuisine type (in CuisineType order).
+    * @return : A view of the dishes in ascending order of the key. Dishes
+    with equal keys keep their slot order. The keys are read from the hot
+    table; kitchens of RADIX_SORT_MIN_SIZE dishes or more are sorted with
+    an LSD radix sort on the integer keys, smaller ones by insertion.
+    */
+    SortedView sortedView(SortKey key) const;
+
     /**
     * @post : Outputs a report of the dishes currently in the kitchen in the
     form:
@@ -137,13 +434,431 @@ public:
 
     AVERAGE PREP TIME: 62
     ELABORATE: 53.85%
+
+    The text comes from report(), so concurrent calls share its cache
+    safely; their output to std::cout may interleave.
     */
     void kitchenReport() const;
 
+    /**
+    * @return : A number that changes whenever the dishes of the kitchen
+    change (it only ever grows). Copies of a kitchen count their own.
+    */
+    uint64_t version() const;
+
+    /**
+    * @return : The report of the current dishes. It is rebuilt only when the
+    version has changed since the last call, and then only the lines whose
+    counter changed are formatted again. The reference stays valid until
+    the kitchen is destroyed; its contents change on the next call after a
+    change to the kitchen. Safe to call from several threads at once while
+    no thread changes the kitchen.
+    */
+    const KitchenReport& report() const;
+
+    /**
+    * @param : A version, as returned by version() or in KitchenReport::version.
+    * @return : The lines of the current report that changed after that
+    version, in report order (every line for version 0). A line that
+    changed and then changed back may be included. Safe to call from several
+    threads at once while no thread changes the kitchen, as report() is.
+    */
+    std::vector<KitchenReportLine> reportChangesSince(uint64_t version) const;
+
+    /**
+    * @param : The queue to publish change events to, or nullptr to stop
+    publishing. The kitchen becomes the queue's only producer; the queue must
+    outlive the kitchen or be detached first. Copies of a kitchen do not
+    publish to it.
+    * @post : Every newOrder, serveDish, bulkLoad and applyBatch change
+    publishes one DISH_ADDED or DISH_SERVED event per dish; every release
+    (including clear and partitionInto, which also publishes DISH_ADDED
+    events to the other kitchen's queue) publishes one BULK_RELEASE event
+    with the number of dishes removed. Copy assignment publishes nothing.
+    */
+    void setEventQueue(KitchenEventQueue* queue);
+
+    /**
+    * @param : The most memory, in bytes, the undo and redo entries may hold.
+    * @post : Starts recording every change made through add, remove,
+    newOrder, serveDish, bulkLoad, applyBatch, the release functions,
+    releaseWhere, partitionInto and clear as one undo entry, dropping the
+    oldest entries when over the budget. Replaces any earlier journal.
+    Copy assignment empties the journal, as its entries no longer apply.
+    */
+    void enableUndo(size_t budget_bytes = 1 << 20);
+
+    /**
+    * @post : Stops recording and discards the journal.
+    */
+    void disableUndo();
+
+    /**
+    * @post : Reverts the most recent change still in the journal, restoring
+    the dishes to their slots and the statistics exactly. Publishes
+    DISH_ADDED for each dish put back and one BULK_RELEASE for the dishes
+    taken out. partitionInto is undone in this kitchen only.
+    * @return : True if there was a change to undo.
+    */
+    bool undo();
+
+    /**
+    * @post : Applies again the most recently undone change. Any other
+    change discards the changes that could be redone.
+    * @return : True if there was a change to redo.
+    */
+    bool redo();
+
+    /**
+    * @return : The number of changes that undo, or redo, can step through.
+    */
+    size_t undoDepth() const;
+    size_t redoDepth() const;
+
+    /**
+    * @return : The memory, in bytes, the journal's entries hold.
+    */
+    size_t undoBytes() const;
+
+    /**
+    * @param : The stream to write to.
+    * @post : Formats every dish in the kitchen, as Dish::display prints it
+    and followed by an empty line, into one buffer and hands it to the
+    stream in a single write, without flushing. For std::cout that is one
+    write(2) for the whole menu instead of five flushes per dish.
+    * @return : The number of characters written.
+    */
+    size_t renderAll(std::ostream& out) const;
+
 private:
+    static const int CUISINE_TYPE_COUNT = Dish::CuisineType::OTHER + 1;
+
     int totalprep_time_; //An integer sum of the preparation times of all the dishes currently in the kitchen
     int countelaborate; //An integer count of all the elaborate dishes in the kitchen
+    int cuisine_counts_[CUISINE_TYPE_COUNT]; //The number of dishes of each cuisine type in the kitchen
+
+    /**
+     * The fields of items_[i] that Kitchen's loops read, in half a cache line.
+     */
+    struct alignas(32) DishHot {
+        uint64_t hash;             // Dish::hash(), compared before calling Dish::operator==
+        double price;
+        int32_t prep_time;
+        uint32_t ingredient_count;
+        int32_t cuisine_type;      // As counted: an out-of-range type is stored as OTHER
+    };
+    static_assert(sizeof(DishHot) == 32, "two DishHot entries per 64-byte cache line");
+
+    DishHot hot_[DEFAULT_CAPACITY]; // hot_[i] describes items_[i] for i < item_count_
+
+    uint64_t version_; // Bumped by every change to the dishes (appendDish, removeSlot, removeAll)
+    mutable KitchenReport report_; // The report as of report_.version
+    mutable uint64_t report_line_versions_[KitchenReport::LINE_COUNT]; // When each line last changed
+    mutable std::atomic<uint64_t> report_version_; // report_.version, read without taking report_mutex_
+    mutable std::mutex report_mutex_; // Held while report_ is rebuilt; not copied with the kitchen
+    KitchenEventQueue* events_; // Where changes are published, or nullptr
+
+    struct Journal; // Defined in Kitchen.cpp
+    std::unique_ptr<Journal> journal_; // The undo journal, or nullptr when undo is off
+
+    /**
+     * Groups the steps of one public change into one undo entry. Nested scopes (newOrder calling
+     * add) belong to the outermost. Costs a null check when undo is off.
+     */
+    class ChangeScope {
+    public:
+        inline explicit ChangeScope(Kitchen& kitchen);
+        inline ~ChangeScope();
+
+    private:
+        Kitchen& kitchen_;
+    };
+
+    /**
+    * @post : Opens, or closes and stores, the undo entry of a change.
+    */
+    void beginChange();
+    void endChange();
+
+    /**
+    * @param : The slot just appended, the slot about to be removed, or (for
+    recordRemoveAll) every slot.
+    * @post : Adds the step to the open undo entry.
+    */
+    void recordAppend(int index);
+    void recordRemove(int index);
+    void recordRemoveAll();
+
+    /**
+    * @param : The slot a dish is removed from when the removals of a
+    compaction are taken one at a time in slot order, and the slot it is in
+    now.
+    * @post : Adds the removal, as one that shifts the later dishes down, to
+    the open undo entry.
+    */
+    void recordRemoveShifting(int slot, int index);
+
+    static const int RADIX_SORT_MIN_SIZE = 48; // Below this, insertion sort beats the radix passes
+
+    /**
+    * @param : A dish and its hash.
+    * @return : The index of the dish in the kitchen, or -1 if it is not in
+    the kitchen.
+    */
+    int findDish(const Dish& dish, uint64_t hash) const;
+
+    /**
+    * @param : A dish entering (direction 1) or leaving (direction -1) the kitchen.
+    * @post : The prep time sum, elaborate count and cuisine counts include
+    (or no longer include) the dish.
+    */
+    void updateStatistics(const Dish& dish, int direction);
+
+    /**
+    * @post : The prep time sum, elaborate count and cuisine counts are
+    recomputed from hot_ in one sweep.
+    */
+    void recomputeStatistics();
+
+    /**
+    * @param : The type of the event and the hot fields of the dish added or
+    served.
+    * @post : Publishes the event if a queue is attached.
+    */
+    inline void publishDish(KitchenEvent::Type type, const DishHot& hot);
+
+    /**
+    * @param : The number of dishes released, and their cuisine type if they
+    all had the same one (-1 otherwise).
+    * @post : Publishes a BULK_RELEASE event if a queue is attached and any
+    dish was released.
+    */
+    inline void publishRelease(int released_count, int cuisine_type);
+
+    /**
+    * @param : A dish that is not in the kitchen, and its hash.
+    * @pre : The kitchen is not full.
+    * @post : Stores the dish in the next free slot and its hot fields in
+    hot_. Does not update the statistics.
+    */
+    void appendDish(const Dish& dish, uint64_t hash);
+
+    /**
+    * @param : The index of a dish in the kitchen.
+    * @post : Removes the dish by moving the last dish into its slot, and
+    updates the statistics. The removed dish is retired, not destroyed.
+    */
+    void removeAt(int index);
+
+    /**
+    * @param : The index of a dish in the kitchen.
+    * @post : removeAt without updating the statistics.
+    */
+    void removeSlot(int index);
+
+    /**
+    * @param : The index of a dish in the kitchen.
+    * @post : Removes the dish by shifting every later dish down one slot,
+    without updating the statistics. The removed dish is retired.
+    */
+    void removeSlotShifting(int index);
+
+    /**
+    * @param : A slot holding a dish to keep, and the lower slot it moves to.
+    * @post : Swaps the two dishes and copies the hot fields down.
+    */
+    void shiftSlot(int from, int to);
+
+    /**
+    * @post : Removes every dish, resets the statistics and releases the
+    arena.
+    * @return : The number of dishes removed.
+    */
+    int removeAll();
+
+    /**
+    * @post : Every slot holds a default Dish bound to the arena, and the
+    arena has handed all of its memory back at once.
+    */
+    void resetSlots();
+
+    /**
+    * @param : A cuisine type in string form and the enum to store it in.
+    * @return : True if the string is one of the cuisine type names, false
+    otherwise.
+    */
+    static bool parseCuisineType(const std::string& cuisine_type, Dish::CuisineType& type);
+
+    /**
+    * @param : A predicate callable as `bool(int slot)`.
+    * @post : Removes the dish in every slot for which the predicate is true,
+    in one pass from the last slot down, so the dish moved into a freed
+    slot has already been checked and the predicate sees every dish once.
+    Keeps the statistics up to date.
+    * @return : The number of dishes removed.
+    */
+    template <typename SlotPredicate>
+    int releaseSlotsWhere(SlotPredicate remove_slot);
+
+    /**
+    * @param : A predicate callable as `bool(int slot)`.
+    * @post : Removes the dish in every slot for which the predicate is true
+    with a stable compaction: one pass in slot order that moves each dish
+    kept down to the slot given by the number of dishes kept before it.
+    The predicate sees every dish once, in slot order. Keeps the
+    statistics up to date.
+    * @return : The number of dishes removed.
+    */
+    template <typename SlotPredicate>
+    int compactSlotsWhere(SlotPredicate remove_slot);
 };
 
+// ********* INLINE FUNCTIONS **************//
+
+inline Kitchen::SortedView::SortedView(const Dish* dishes, std::vector<int> order)
+    : dishes_(dishes), order_(std::move(order)) {
+}
+
+inline Kitchen::SortedView::iterator Kitchen::SortedView::begin() const {
+    return iterator(this, 0);
+}
+
+inline Kitchen::SortedView::iterator Kitchen::SortedView::end() const {
+    return iterator(this, order_.size());
+}
+
+inline size_t Kitchen::SortedView::size() const {
+    return order_.size();
+}
+
+inline const Dish& Kitchen::SortedView::operator[](size_t index) const {
+    return dishes_[order_[index]];
+}
+
+inline const std::vector<int>& Kitchen::SortedView::order() const {
+    return order_;
+}
+
+inline Kitchen::SortedView::iterator::iterator(const SortedView* view, size_t index) : view_(view), index_(index) {
+}
+
+inline const Dish& Kitchen::SortedView::iterator::operator*() const {
+    return (*view_)[index_];
+}
+
+inline Kitchen::SortedView::iterator& Kitchen::SortedView::iterator::operator++() {
+    ++index_;
+    return *this;
+}
+
+inline Kitchen::SortedView::iterator Kitchen::SortedView::iterator::operator++(int) {
+    iterator previous = *this;
+    ++index_;
+    return previous;
+}
+
+inline bool Kitchen::SortedView::iterator::operator==(const iterator& other) const {
+    return view_ == other.view_ && index_ == other.index_;
+}
+
+inline bool Kitchen::SortedView::iterator::operator!=(const iterator& other) const {
+    return !(*this == other);
+}
+
+inline Kitchen::ChangeScope::ChangeScope(Kitchen& kitchen) : kitchen_(kitchen) {
+    if (kitchen_.journal_ != nullptr) {
+        kitchen_.beginChange();
+    }
+}
+
+inline Kitchen::ChangeScope::~ChangeScope() {
+    if (kitchen_.journal_ != nullptr) {
+        kitchen_.endChange();
+    }
+}
+
+inline void Kitchen::publishDish(KitchenEvent::Type type, const DishHot& hot) {
+    if (events_ != nullptr) {
+        events_->tryPush({type, static_cast<int8_t>(hot.cuisine_type), hot.prep_time, 1, version_, hot.hash});
+    }
+}
+
+inline void Kitchen::publishRelease(int released_count, int cuisine_type) {
+    if (events_ != nullptr && released_count > 0) {
+        events_->tryPush({KitchenEvent::BULK_RELEASE, static_cast<int8_t>(cuisine_type), 0, released_count, version_, 0});
+    }
+}
+
+template <typename Predicate>
+int Kitchen::releaseWhere(Predicate predicate) {
+    ChangeScope scope(*this);
+    int removed_count =
+        releaseSlotsWhere([&](int slot) { return static_cast<bool>(predicate(static_cast<const Dish&>(items_[slot]))); });
+    publishRelease(removed_count, -1);
+    return removed_count;
+}
+
+template <typename Predicate>
+int Kitchen::partitionInto(Kitchen& other, Predicate predicate) {
+    if (&other == this) {
+        return 0;
+    }
+    ChangeScope scope(*this);
+    ChangeScope other_scope(other);
+    int moved_count = releaseSlotsWhere([&](int slot) {
+        const Dish& dish = items_[slot];
+        if (!predicate(dish) || other.item_count_ >= DEFAULT_CAPACITY || other.findDish(dish, hot_[slot].hash) >= 0) {
+            return false;
+        }
+        // Different kitchens have different arenas, so the strings are copied into the other one
+        other.appendDish(dish, hot_[slot].hash);
+        other.updateStatistics(dish, 1);
+        other.publishDish(KitchenEvent::DISH_ADDED, other.hot_[other.item_count_ - 1]);
+        return true;
+    });
+    publishRelease(moved_count, -1);
+    return moved_count;
+}
+
+template <typename SlotPredicate>
+int Kitchen::releaseSlotsWhere(SlotPredicate remove_slot) {
+    // Filling each gap with the last dish moves one dish per removal; keeping the order would move
+    // every dish after the first removal
+    int removed_count = 0;
+    for (int i = item_count_ - 1; i >= 0; --i) {
+        if (remove_slot(i)) {
+            removeAt(i);
+            removed_count++;
+        }
+    }
+    return removed_count;
+}
+
+template <typename SlotPredicate>
+int Kitchen::compactSlotsWhere(SlotPredicate remove_slot) {
+    // `kept` is the running (exclusive prefix) sum of the keep flags: where the next kept dish goes.
+    // The removed dishes are swapped up past it and end up in the pool of retired dishes.
+    int count = item_count_;
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        if (remove_slot(i)) {
+            if (journal_ != nullptr) {
+                recordRemoveShifting(kept, i);
+            }
+            updateStatistics(items_[i], -1);
+        } else {
+            if (kept != i) {
+                shiftSlot(i, kept);
+            }
+            kept++;
+        }
+    }
+    if (kept != count) {
+        item_count_ = kept;
+        version_++;
+    }
+    return count - kept;
+}
+
 #endif  // KITCHEN_HPP
 
@@ -0,0 +1,211 @@
+/**
+ * @file KitchenEvents.cpp
+ * @brief This file contains the implementation of the KitchenEventQueue and KitchenEventDispatcher
+ * classes, which carry a kitchen's change notifications to its subscribers.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "KitchenEvents.hpp"
+#include <algorithm> // For std::min, std::remove_if
+
+/**
+ * @param capacity The number of events the ring holds, rounded up to a power of two.
+ */
+KitchenEventQueue::KitchenEventQueue(size_t capacity) : tail_(0), cached_head_(0), dropped_(0), head_(0) {
+    size_t rounded = 1;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+    slots_.resize(rounded);
+    mask_ = rounded - 1;
+}
+
+/**
+ * @return The number of events taken, oldest first.
+ */
+size_t KitchenEventQueue::popBatch(KitchenEvent* out, size_t max_count) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t available = tail_.load(std::memory_order_acquire) - head;
+    size_t count = std::min(available, max_count);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = slots_[(head + i) & mask_];
+    }
+    // Hands the slots back to the producer only after they have been copied out
+    head_.store(head + count, std::memory_order_release);
+    return count;
+}
+
+/**
+ * @return The number of events the ring holds.
+ */
+size_t KitchenEventQueue::capacity() const {
+    return slots_.size();
+}
+
+/**
+ * @return The number of events dropped because the ring was full.
+ */
+uint64_t KitchenEventQueue::dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @return The subscription mask bit of that type.
+ */
+uint32_t KitchenEventDispatcher::maskOf(KitchenEvent::Type type) {
+    return 1u << type;
+}
+
+/**
+ * @param queue The queue to drain.
+ * @param interval How long the events of one batch are coalesced for.
+ * @param max_batch_events The most events a batch carries.
+ */
+KitchenEventDispatcher::KitchenEventDispatcher(KitchenEventQueue& queue, std::chrono::milliseconds interval,
+                                               size_t max_batch_events)
+    : queue_(queue), interval_(interval), max_batch_events_(max_batch_events), next_id_(1),
+      interval_start_(std::chrono::steady_clock::now()), dropped_seen_(queue.dropped()),
+      scratch_(queue.capacity()), stopping_(false) {
+    batch_.events.reserve(max_batch_events);
+}
+
+/**
+ * @post Stops the dispatch thread and delivers the last interval.
+ */
+KitchenEventDispatcher::~KitchenEventDispatcher() {
+    stop();
+}
+
+/**
+ * @return An id for unsubscribe.
+ */
+int KitchenEventDispatcher::subscribe(uint32_t event_mask, Callback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscribers_.push_back({next_id_, event_mask, std::move(callback)});
+    return next_id_++;
+}
+
+/**
+ * @post The callback is not called again.
+ */
+void KitchenEventDispatcher::unsubscribe(int id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    subscribers_.erase(std::remove_if(subscribers_.begin(), subscribers_.end(),
+                                      [id](const Subscriber& subscriber) { return subscriber.id == id; }),
+                       subscribers_.end());
+}
+
+/**
+ * @post Moves the queued events into the current interval, and delivers it if the interval is over.
+ * @return The number of events taken from the queue.
+ */
+size_t KitchenEventDispatcher::poll() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t taken = drainLocked();
+    if (std::chrono::steady_clock::now() - interval_start_ >= interval_) {
+        deliverLocked();
+    }
+    return taken;
+}
+
+/**
+ * @post Moves the queued events into the current interval and delivers it now.
+ */
+void KitchenEventDispatcher::flush() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    drainLocked();
+    deliverLocked();
+}
+
+/**
+ * @post Starts a thread that polls every quarter interval.
+ */
+void KitchenEventDispatcher::start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (thread_.joinable()) {
+        return;
+    }
+    stopping_ = false;
+    thread_ = std::thread([this] {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stopping_) {
+            stop_requested_.wait_for(lock, interval_ / 4, [this] { return stopping_; });
+            drainLocked();
+            if (std::chrono::steady_clock::now() - interval_start_ >= interval_) {
+                deliverLocked();
+            }
+        }
+    });
+}
+
+/**
+ * @post Stops the dispatch thread, if running, and delivers the last interval.
+ */
+void KitchenEventDispatcher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    stop_requested_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    flush();
+}
+
+// Drains the queue into batch_; the caller holds mutex_
+size_t KitchenEventDispatcher::drainLocked() {
+    KitchenEventSummary& summary = batch_.summary;
+    size_t total = 0;
+    size_t taken;
+    while ((taken = queue_.popBatch(scratch_.data(), scratch_.size())) > 0) {
+        for (size_t i = 0; i < taken; i++) {
+            const KitchenEvent& event = scratch_[i];
+            if (summary.event_count == 0) {
+                summary.first_version = event.version;
+            }
+            summary.last_version = event.version;
+            summary.event_count++;
+            summary.type_mask |= maskOf(event.type);
+            bool known_cuisine = event.cuisine_type >= 0 && event.cuisine_type < KitchenEvent::CUISINE_TYPE_COUNT;
+            if (event.type == KitchenEvent::DISH_ADDED) {
+                summary.added += event.count;
+                if (known_cuisine) {
+                    summary.added_by_cuisine[event.cuisine_type] += event.count;
+                }
+            } else if (event.type == KitchenEvent::DISH_SERVED) {
+                summary.served += event.count;
+                if (known_cuisine) {
+                    summary.served_by_cuisine[event.cuisine_type] += event.count;
+                }
+            } else {
+                summary.released += event.count;
+            }
+            if (batch_.events.size() < max_batch_events_) {
+                batch_.events.push_back(event);
+            }
+        }
+        total += taken;
+    }
+    return total;
+}
+
+// Delivers batch_ if it has events or drops, then starts a new interval; the caller holds mutex_
+void KitchenEventDispatcher::deliverLocked() {
+    uint64_t dropped = queue_.dropped();
+    batch_.summary.dropped = dropped - dropped_seen_;
+    dropped_seen_ = dropped;
+    if (batch_.summary.event_count > 0 || batch_.summary.dropped > 0) {
+        for (const Subscriber& subscriber : subscribers_) {
+            // A batch of nothing but drops goes to everyone, as any of their events may be among them
+            if ((subscriber.event_mask & batch_.summary.type_mask) != 0 || batch_.summary.event_count == 0) {
+                subscriber.callback(batch_);
+            }
+        }
+    }
+    batch_.summary = KitchenEventSummary();
+    batch_.events.clear();
+    interval_start_ = std::chrono::steady_clock::now();
+}
@@ -0,0 +1,235 @@
+/**
+ * @file KitchenEvents.hpp
+ * @brief This file contains the change notifications of Kitchen: the KitchenEvent record, the
+ * lock-free KitchenEventQueue a kitchen publishes into, and the KitchenEventDispatcher that drains
+ * the queue and delivers coalesced batches to subscribers.
+ *
+ * A kitchen with a queue attached (Kitchen::setEventQueue) pushes one 32-byte event per added or
+ * served dish and one per bulk release. The push is a few plain stores and one release store into
+ * a single-producer, single-consumer ring; it never blocks, allocates or calls an observer. If the
+ * ring is full the event is dropped and counted, so a stalled consumer cannot slow the kitchen.
+ *
+ * The dispatcher runs on the consumer side, either polled by the caller or on its own thread. It
+ * folds the events of each interval into a KitchenEventSummary (counts per event type and cuisine
+ * type, versions covered, events dropped) and hands every subscriber interested in one of the
+ * interval's event types a single batch: the summary plus the first events of the interval.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef KITCHEN_EVENTS_HPP
+#define KITCHEN_EVENTS_HPP
+
+#include "Dish.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * One change to a kitchen.
+ */
+struct KitchenEvent {
+    enum Type : uint8_t { DISH_ADDED, DISH_SERVED, BULK_RELEASE, TYPE_COUNT };
+    static const int CUISINE_TYPE_COUNT = Dish::CuisineType::OTHER + 1;
+
+    Type type;
+    int8_t cuisine_type; // The dish's Dish::CuisineType; for a release, -1 unless every dish had this type
+    int32_t prep_time;   // The dish's prep time; 0 for a release
+    int32_t count;       // 1, or the number of dishes released
+    uint64_t version;    // Kitchen::version() just after the change
+    uint64_t dish_hash;  // The dish's Dish::hash(); 0 for a release
+};
+
+/**
+ * A bounded single-producer, single-consumer ring of events. tryPush may only be called from one
+ * thread at a time (the kitchen's), and popBatch from one thread at a time (the dispatcher's).
+ */
+class KitchenEventQueue {
+public:
+    /**
+     * @param capacity The number of events the ring holds, rounded up to a power of two.
+     */
+    explicit KitchenEventQueue(size_t capacity = 4096);
+
+    KitchenEventQueue(const KitchenEventQueue&) = delete;
+    KitchenEventQueue& operator=(const KitchenEventQueue&) = delete;
+
+    /**
+     * @param event The event to publish.
+     * @post Appends the event, or counts it as dropped if the ring is full. Never blocks.
+     * @return True if the event was appended.
+     */
+    inline bool tryPush(const KitchenEvent& event);
+
+    /**
+     * @param out Where to copy the events.
+     * @param max_count The most events to take.
+     * @post Removes up to max_count of the oldest events and copies them to out, oldest first.
+     * @return The number of events taken.
+     */
+    size_t popBatch(KitchenEvent* out, size_t max_count);
+
+    /**
+     * @return The number of events the ring holds.
+     */
+    size_t capacity() const;
+
+    /**
+     * @return The number of events dropped because the ring was full, since it was created.
+     */
+    uint64_t dropped() const;
+
+private:
+    std::vector<KitchenEvent> slots_;
+    size_t mask_; // capacity - 1
+
+    // The producer and the consumer each write their own cache line
+    alignas(64) std::atomic<size_t> tail_; // Next slot to write; written by the producer
+    size_t cached_head_;                   // The producer's last look at head_
+    std::atomic<uint64_t> dropped_;
+    alignas(64) std::atomic<size_t> head_; // Next slot to read; written by the consumer
+};
+
+/**
+ * The events of one interval, coalesced.
+ */
+struct KitchenEventSummary {
+    uint64_t first_version = 0; // Version after the first event of the interval
+    uint64_t last_version = 0;  // Version after the last event of the interval
+    size_t event_count = 0;
+    long long added = 0;
+    long long served = 0;
+    long long released = 0;     // Dishes removed by bulk releases
+    long long added_by_cuisine[KitchenEvent::CUISINE_TYPE_COUNT] = {};
+    long long served_by_cuisine[KitchenEvent::CUISINE_TYPE_COUNT] = {};
+    uint64_t dropped = 0;       // Events lost to a full queue since the previous interval
+    uint32_t type_mask = 0;     // Bit KitchenEvent::Type set for every type that occurred
+};
+
+/**
+ * What a subscriber receives once per interval.
+ */
+struct KitchenEventBatch {
+    KitchenEventSummary summary;
+    std::vector<KitchenEvent> events; // The first events of the interval, oldest first
+};
+
+class KitchenEventDispatcher {
+public:
+    using Callback = std::function<void(const KitchenEventBatch&)>;
+
+    static const uint32_t ALL_EVENTS = (1u << KitchenEvent::TYPE_COUNT) - 1;
+
+    /**
+     * @param type An event type.
+     * @return The subscription mask bit of that type.
+     */
+    static uint32_t maskOf(KitchenEvent::Type type);
+
+    /**
+     * @param queue The queue to drain; must outlive the dispatcher.
+     * @param interval How long the events of one batch are coalesced for.
+     * @param max_batch_events The most events a batch carries; the summary counts all of them.
+     */
+    KitchenEventDispatcher(KitchenEventQueue& queue, std::chrono::milliseconds interval,
+                           size_t max_batch_events = 256);
+
+    /**
+     * @post Stops the dispatch thread, if running, and delivers the last interval.
+     */
+    ~KitchenEventDispatcher();
+
+    KitchenEventDispatcher(const KitchenEventDispatcher&) = delete;
+    KitchenEventDispatcher& operator=(const KitchenEventDispatcher&) = delete;
+
+    /**
+     * @param event_mask The event types to be called for, as maskOf bits or ALL_EVENTS.
+     * @param callback Called with every batch that contains one of those event types, on the
+     * thread that delivers it. It must not subscribe, unsubscribe or poll.
+     * @return An id for unsubscribe.
+     */
+    int subscribe(uint32_t event_mask, Callback callback);
+
+    /**
+     * @param id An id returned by subscribe.
+     * @post The callback is not called again.
+     */
+    void unsubscribe(int id);
+
+    /**
+     * @post Moves the queued events into the current interval, and delivers the interval if it
+     * has lasted at least the interval length.
+     * @return The number of events taken from the queue.
+     */
+    size_t poll();
+
+    /**
+     * @post Moves the queued events into the current interval and delivers it now.
+     */
+    void flush();
+
+    /**
+     * @post Starts a thread that polls every quarter interval. Does nothing if already started.
+     */
+    void start();
+
+    /**
+     * @post Stops the dispatch thread, if running, and delivers the last interval.
+     */
+    void stop();
+
+private:
+    struct Subscriber {
+        int id;
+        uint32_t event_mask;
+        Callback callback;
+    };
+
+    KitchenEventQueue& queue_;
+    std::chrono::milliseconds interval_;
+    size_t max_batch_events_;
+
+    std::mutex mutex_; // Guards everything below; held while draining and delivering
+    std::vector<Subscriber> subscribers_;
+    int next_id_;
+    KitchenEventBatch batch_;                              // The current interval
+    std::chrono::steady_clock::time_point interval_start_;
+    uint64_t dropped_seen_;                                // queue_.dropped() when the last interval was delivered
+    std::vector<KitchenEvent> scratch_;                    // popBatch buffer
+
+    std::thread thread_;
+    std::condition_variable stop_requested_;
+    bool stopping_;
+
+    // Drains the queue into batch_; the caller holds mutex_
+    size_t drainLocked();
+
+    // Delivers batch_ if it has events or drops, then starts a new interval; the caller holds mutex_
+    void deliverLocked();
+};
+
+// ********* INLINE FUNCTIONS **************//
+
+inline bool KitchenEventQueue::tryPush(const KitchenEvent& event) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - cached_head_ > mask_) {
+        // Looks full: only now read the consumer's index, which costs a cache line transfer
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (tail - cached_head_ > mask_) {
+            dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+    slots_[tail & mask_] = event;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+#endif // KITCHEN_EVENTS_HPP
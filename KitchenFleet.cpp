@@ -0,0 +1,114 @@
+/**
+ * @file KitchenFleet.cpp
+ * @brief This file contains the implementation of the KitchenFleet class, a set of kitchens whose
+ * scans, releases and report run in parallel on a ThreadPool.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "KitchenFleet.hpp"
+#include <cmath>   // For std::round
+#include <iomanip> // For std::setprecision
+
+/**
+ * @post Adds the other tally to this one.
+ */
+void FleetTally::add(const FleetTally& other) {
+    dishes += other.dishes;
+    prep_time_sum += other.prep_time_sum;
+    elaborate += other.elaborate;
+    for (int type = 0; type < CUISINE_TYPE_COUNT; type++) {
+        cuisine_counts[type] += other.cuisine_counts[type];
+    }
+}
+
+/**
+ * @param kitchen_count The number of kitchens, all empty.
+ */
+KitchenFleet::KitchenFleet(size_t kitchen_count) : kitchens_(kitchen_count) {
+}
+
+/**
+ * @return The number of kitchens.
+ */
+size_t KitchenFleet::size() const {
+    return kitchens_.size();
+}
+
+/**
+ * @return The kitchen at that index.
+ */
+Kitchen& KitchenFleet::operator[](size_t index) {
+    return kitchens_[index];
+}
+
+const Kitchen& KitchenFleet::operator[](size_t index) const {
+    return kitchens_[index];
+}
+
+/**
+ * @return The dish count, prep time sum, elaborate count and cuisine histogram of the fleet.
+ */
+FleetTally KitchenFleet::tally(ThreadPool& pool) const {
+    return pool.parallelReduce(
+        kitchens_.size(), KITCHENS_PER_CHUNK, FleetTally(),
+        [this](size_t begin, size_t end) {
+            FleetTally partial;
+            for (size_t k = begin; k < end; k++) {
+                const Kitchen& kitchen = kitchens_[k];
+                partial.dishes += kitchen.getCurrentSize();
+                partial.prep_time_sum += kitchen.getPrepTimeSum();
+                partial.elaborate += kitchen.elaborateDishCount();
+                for (int type = 0; type < FleetTally::CUISINE_TYPE_COUNT; type++) {
+                    partial.cuisine_counts[type] += kitchen.cuisineCount(static_cast<Dish::CuisineType>(type));
+                }
+            }
+            return partial;
+        },
+        [](FleetTally total, const FleetTally& partial) {
+            total.add(partial);
+            return total;
+        });
+}
+
+/**
+ * @post Calls releaseDishesBelowPrepTime on every kitchen, spread over the threads; each kitchen
+ * is compacted stably.
+ * @return The number of dishes removed from the fleet.
+ */
+long long KitchenFleet::releaseDishesBelowPrepTime(int prep_time_threshold, ThreadPool& pool) {
+    return pool.parallelReduce(
+        kitchens_.size(), KITCHENS_PER_CHUNK, 0LL,
+        [this, prep_time_threshold](size_t begin, size_t end) {
+            long long removed = 0;
+            for (size_t k = begin; k < end; k++) {
+                removed += kitchens_[k].releaseDishesBelowPrepTime(prep_time_threshold);
+            }
+            return removed;
+        },
+        [](long long total, long long partial) { return total + partial; });
+}
+
+/**
+ * @post Outputs the report of Kitchen::kitchenReport for the whole fleet.
+ */
+void KitchenFleet::report(std::ostream& out, ThreadPool& pool) const {
+    FleetTally totals = tally(pool);
+
+    // Output the cuisine type counts
+    for (int type = 0; type < FleetTally::CUISINE_TYPE_COUNT; type++) {
+        out << Dish::cuisineName(static_cast<Dish::CuisineType>(type)) << ": " << totals.cuisine_counts[type] << '\n';
+    }
+
+    // Average preparation time and percentage of elaborate dishes, rounded as a single kitchen does
+    long long avg_prep_time = 0;
+    double elaborate_percentage = 0;
+    if (totals.dishes > 0) {
+        avg_prep_time = std::llround(static_cast<double>(totals.prep_time_sum) / totals.dishes);
+        elaborate_percentage = (static_cast<double>(totals.elaborate) / totals.dishes) * 100;
+        elaborate_percentage = std::round(elaborate_percentage * 100) / 100;
+    }
+    out << "\nAVERAGE PREP TIME: " << avg_prep_time << '\n';
+    out << "ELABORATE: " << std::fixed << std::setprecision(2) << elaborate_percentage << "%" << std::endl;
+}
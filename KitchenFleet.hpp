@@ -0,0 +1,147 @@
+/**
+ * @file KitchenFleet.hpp
+ * @brief This file contains the declaration of the KitchenFleet class, a set of kitchens (the
+ * simulated fleet) whose scans, releases and report run in parallel on a ThreadPool.
+ *
+ * A single Kitchen holds at most 100 dishes, so the work worth spreading over cores is the fleet.
+ * The kitchens are split into chunks; each chunk produces partial sums and a partial cuisine
+ * histogram from the kitchens' maintained counters, and the partials are combined in chunk order,
+ * so the results are the same for any number of threads. Every kitchen has its own arena, so
+ * releases in different kitchens never share memory and need no locking.
+ *
+ * The fleet release is a stable compaction: the chunks run in parallel, and within each kitchen
+ * Kitchen::releaseDishesBelowPrepTime makes one pass that moves every dish kept to the slot given
+ * by the running (prefix) sum of the dishes kept before it, so the fleet keeps its order. Kitchens
+ * are never more than 100 dishes, so one kitchen is not split across threads.
+ *
+ * findDishes gathers matching dishes from the whole fleet with a parallel stable compaction: each
+ * chunk counts its matches, an exclusive prefix sum of the counts gives every chunk its offset in
+ * the output, and each chunk then writes its matches there, in fleet order.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef KITCHEN_FLEET_HPP
+#define KITCHEN_FLEET_HPP
+
+#include "Dish.hpp"
+#include "Kitchen.hpp"
+#include "ThreadPool.hpp"
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+/**
+ * Totals of a fleet, combined from the kitchens' maintained counters.
+ */
+struct FleetTally {
+    static const int CUISINE_TYPE_COUNT = Dish::CuisineType::OTHER + 1;
+
+    long long dishes = 0;
+    long long prep_time_sum = 0;
+    long long elaborate = 0;
+    long long cuisine_counts[CUISINE_TYPE_COUNT] = {};
+
+    /**
+     * @param other The tally of other kitchens.
+     * @post Adds the other tally to this one.
+     */
+    void add(const FleetTally& other);
+};
+
+class KitchenFleet {
+public:
+    static const size_t KITCHENS_PER_CHUNK = 16; // Kitchens one thread takes at a time
+
+    /**
+     * @param kitchen_count The number of kitchens, all empty.
+     */
+    explicit KitchenFleet(size_t kitchen_count);
+
+    /**
+     * @return The number of kitchens.
+     */
+    size_t size() const;
+
+    /**
+     * @param index An index less than size().
+     * @return The kitchen at that index.
+     */
+    Kitchen& operator[](size_t index);
+    const Kitchen& operator[](size_t index) const;
+
+    /**
+     * @param pool The threads to run on.
+     * @return The dish count, prep time sum, elaborate count and cuisine histogram of the fleet.
+     */
+    FleetTally tally(ThreadPool& pool) const;
+
+    /**
+     * @param prep_time_threshold As for Kitchen::releaseDishesBelowPrepTime.
+     * @param pool The threads to run on.
+     * @post Calls releaseDishesBelowPrepTime on every kitchen, spread over the threads. Each
+     * kitchen is compacted stably, so the dishes kept stay in fleet order.
+     * @return The number of dishes removed from the fleet.
+     */
+    long long releaseDishesBelowPrepTime(int prep_time_threshold, ThreadPool& pool);
+
+    /**
+     * @param predicate A predicate callable as `bool(const Dish&)`.
+     * @param pool The threads to run on.
+     * @return Pointers to every dish of the fleet for which the predicate is true, in fleet order
+     * (kitchen by kitchen, each kitchen in its iteration order). Any change to a kitchen
+     * invalidates them.
+     */
+    template <typename Predicate>
+    std::vector<const Dish*> findDishes(Predicate predicate, ThreadPool& pool) const;
+
+    /**
+     * @param out The stream to write to.
+     * @param pool The threads to run on.
+     * @post Outputs the report of Kitchen::kitchenReport for the whole fleet.
+     */
+    void report(std::ostream& out, ThreadPool& pool) const;
+
+private:
+    std::vector<Kitchen> kitchens_;
+};
+
+// ********* INLINE FUNCTIONS **************//
+
+template <typename Predicate>
+std::vector<const Dish*> KitchenFleet::findDishes(Predicate predicate, ThreadPool& pool) const {
+    size_t chunks = (kitchens_.size() + KITCHENS_PER_CHUNK - 1) / KITCHENS_PER_CHUNK;
+
+    // Count the matches of every chunk
+    std::vector<size_t> offsets(chunks + 1, 0);
+    pool.parallelFor(kitchens_.size(), KITCHENS_PER_CHUNK, [&](size_t begin, size_t end) {
+        size_t matches = 0;
+        for (size_t k = begin; k < end; k++) {
+            for (const Dish& dish : kitchens_[k]) {
+                matches += predicate(dish) ? 1 : 0;
+            }
+        }
+        offsets[begin / KITCHENS_PER_CHUNK + 1] = matches;
+    });
+
+    // Exclusive prefix sum: offsets[c] is where chunk c starts writing
+    for (size_t c = 0; c < chunks; c++) {
+        offsets[c + 1] += offsets[c];
+    }
+
+    std::vector<const Dish*> found(offsets[chunks]);
+    pool.parallelFor(kitchens_.size(), KITCHENS_PER_CHUNK, [&](size_t begin, size_t end) {
+        size_t next = offsets[begin / KITCHENS_PER_CHUNK];
+        for (size_t k = begin; k < end; k++) {
+            for (const Dish& dish : kitchens_[k]) {
+                if (predicate(dish)) {
+                    found[next++] = &dish;
+                }
+            }
+        }
+    });
+    return found;
+}
+
+#endif // KITCHEN_FLEET_HPP
@@ -0,0 +1,229 @@
+/**
+ * @file KitchenLatency.cpp
+ * @brief This file contains the implementation of the KitchenLatency class, sampled latency histograms
+ * for the Kitchen operations.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "KitchenLatency.hpp"
+#include <iomanip> // For std::setw
+#include <mutex>
+#include <thread>  // For std::this_thread::sleep_for
+
+// Registry of the shards of live threads; shards of exited threads are folded into `retired_shard`
+static std::mutex registry_mutex;
+static KitchenLatency::Shard* registry_head = nullptr;
+static KitchenLatency::Shard retired_shard;
+
+// Reference points for converting ticks to nanoseconds, taken when the program starts
+static const uint64_t start_ticks = KitchenLatency::now();
+static const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+
+// Owns the calling thread's shard: registers it on creation, retires it when the thread exits
+struct ShardOwner {
+    KitchenLatency::Shard* shard;
+
+    ShardOwner() : shard(new KitchenLatency::Shard) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        shard->next = registry_head;
+        registry_head = shard;
+    }
+
+    ~ShardOwner() {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (int op = 0; op < KitchenLatency::OP_COUNT; op++) {
+            for (int i = 0; i < LatencyHistogram::BUCKET_COUNT; i++) {
+                uint64_t count = shard->counts[op][i].load(std::memory_order_relaxed);
+                if (count != 0) {
+                    retired_shard.counts[op][i].fetch_add(count, std::memory_order_relaxed);
+                }
+            }
+            retired_shard.calls[op].fetch_add(shard->calls[op].load(std::memory_order_relaxed),
+                                              std::memory_order_relaxed);
+        }
+        KitchenLatency::Shard** link = &registry_head;
+        while (*link != shard) {
+            link = &(*link)->next;
+        }
+        *link = shard->next;
+        delete shard;
+
+        // Anything this thread still times while shutting down goes straight to the retired shard
+        KitchenLatency::local_shard_ = &retired_shard;
+    }
+};
+
+KitchenLatency::Shard& KitchenLatency::registerThread() {
+    thread_local ShardOwner owner;
+    local_shard_ = owner.shard;
+    return *owner.shard;
+}
+
+/**
+ * @param on True to count and sample calls, false to turn the timers off.
+ */
+void KitchenLatency::setEnabled(bool on) {
+    enabled_.store(on, std::memory_order_relaxed);
+}
+
+/**
+ * @param interval Time one call in every `interval` from the next sample on.
+ */
+void KitchenLatency::setSampleInterval(uint32_t interval) {
+    sample_interval_.store(interval == 0 ? 1 : interval, std::memory_order_relaxed);
+}
+
+/**
+ * @return The current sampling interval.
+ */
+uint32_t KitchenLatency::sampleInterval() {
+    return sample_interval_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @return The exact number of calls of `op` counted by every thread.
+ */
+uint64_t KitchenLatency::callCount(Op op) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    uint64_t calls = retired_shard.calls[op].load(std::memory_order_relaxed);
+    for (Shard* shard = registry_head; shard != nullptr; shard = shard->next) {
+        calls += shard->calls[op].load(std::memory_order_relaxed);
+    }
+    return calls;
+}
+
+/**
+ * @return The latencies of `op` sampled by every thread, in nanoseconds, weighted by the calls
+ * each sample stands for.
+ */
+LatencyHistogram KitchenLatency::snapshot(Op op) {
+    // Merge the tick counts of every shard, then map each tick bucket to nanoseconds
+    std::vector<uint64_t> ticks(LatencyHistogram::BUCKET_COUNT, 0);
+    {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        for (int i = 0; i < LatencyHistogram::BUCKET_COUNT; i++) {
+            ticks[i] = retired_shard.counts[op][i].load(std::memory_order_relaxed);
+        }
+        for (Shard* shard = registry_head; shard != nullptr; shard = shard->next) {
+            for (int i = 0; i < LatencyHistogram::BUCKET_COUNT; i++) {
+                ticks[i] += shard->counts[op][i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    double ns_per_tick = nanosecondsPerTick();
+    LatencyHistogram histogram;
+    for (int i = 0; i < LatencyHistogram::BUCKET_COUNT; i++) {
+        if (ticks[i] != 0) {
+            double middle = (static_cast<double>(LatencyHistogram::bucketLowerBound(i)) +
+                             LatencyHistogram::bucketUpperBound(i)) / 2;
+            histogram.record(static_cast<uint64_t>(middle * ns_per_tick), ticks[i]);
+        }
+    }
+    return histogram;
+}
+
+/**
+ * @post Every counter and histogram of every thread is empty, and every thread samples its next call.
+ * Counts recorded concurrently with the reset may survive it.
+ */
+void KitchenLatency::reset() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    for (int op = 0; op < OP_COUNT; op++) {
+        for (int i = 0; i < LatencyHistogram::BUCKET_COUNT; i++) {
+            retired_shard.counts[op][i].store(0, std::memory_order_relaxed);
+            for (Shard* shard = registry_head; shard != nullptr; shard = shard->next) {
+                shard->counts[op][i].store(0, std::memory_order_relaxed);
+            }
+        }
+        retired_shard.calls[op].store(0, std::memory_order_relaxed);
+        for (Shard* shard = registry_head; shard != nullptr; shard = shard->next) {
+            shard->calls[op].store(0, std::memory_order_relaxed);
+        }
+    }
+    for (Shard* shard = registry_head; shard != nullptr; shard = shard->next) {
+        shard->countdown.store(1, std::memory_order_relaxed);
+        shard->weight.store(1, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @return The name of the Kitchen function.
+ */
+const char* KitchenLatency::opName(int op) {
+    switch (op) {
+        case NEW_ORDER: return "newOrder";
+        case SERVE_DISH: return "serveDish";
+        case RELEASE_DISHES_BELOW_PREP_TIME: return "releaseDishesBelowPrepTime";
+        case RELEASE_DISHES_OF_CUISINE_TYPE: return "releaseDishesOfCuisineType";
+        case KITCHEN_REPORT: return "kitchenReport";
+        default: return "unknown";
+    }
+}
+
+/**
+ * @post Outputs the exact call count and the sampled mean, p50, p90, p99, p99.9 and max (in ns) of
+ * every operation, one line each.
+ */
+void KitchenLatency::writeText(std::ostream& out) {
+    out << std::left << std::setw(28) << "operation (ns)" << std::right << std::setw(12) << "count"
+        << std::setw(10) << "mean" << std::setw(10) << "p50" << std::setw(10) << "p90" << std::setw(10) << "p99"
+        << std::setw(10) << "p99.9" << std::setw(12) << "max" << '\n';
+    for (int op = 0; op < OP_COUNT; op++) {
+        LatencyHistogram histogram = snapshot(static_cast<Op>(op));
+        out << std::left << std::setw(28) << opName(op) << std::right << std::setw(12) << callCount(static_cast<Op>(op))
+            << std::setw(10) << static_cast<uint64_t>(histogram.mean())
+            << std::setw(10) << histogram.valueAtPercentile(50) << std::setw(10) << histogram.valueAtPercentile(90)
+            << std::setw(10) << histogram.valueAtPercentile(99) << std::setw(10) << histogram.valueAtPercentile(99.9)
+            << std::setw(12) << histogram.max() << '\n';
+    }
+}
+
+/**
+ * @post Outputs the same summary as writeText, plus the non-empty buckets, as a JSON object.
+ */
+void KitchenLatency::writeJson(std::ostream& out) {
+    out << "{\"unit\": \"ns\", \"operations\": {";
+    for (int op = 0; op < OP_COUNT; op++) {
+        LatencyHistogram histogram = snapshot(static_cast<Op>(op));
+        out << (op == 0 ? "" : ", ") << '"' << opName(op) << "\": {\"count\": " << callCount(static_cast<Op>(op))
+            << ", \"mean\": " << histogram.mean() << ", \"p50\": " << histogram.valueAtPercentile(50)
+            << ", \"p90\": " << histogram.valueAtPercentile(90) << ", \"p99\": " << histogram.valueAtPercentile(99)
+            << ", \"p99.9\": " << histogram.valueAtPercentile(99.9) << ", \"max\": " << histogram.max()
+            << ", \"buckets\": [";
+        bool first = true;
+        for (int i = 0; i < LatencyHistogram::BUCKET_COUNT; i++) {
+            if (histogram.bucketCount(i) != 0) {
+                out << (first ? "" : ", ") << '[' << LatencyHistogram::bucketUpperBound(i) << ", "
+                    << histogram.bucketCount(i) << ']';
+                first = false;
+            }
+        }
+        out << "]}";
+    }
+    out << "}}";
+}
+
+/**
+ * @return The length of one tick in nanoseconds.
+ */
+double KitchenLatency::nanosecondsPerTick() {
+#if defined(__x86_64__) || defined(__i386__)
+    static const double ns_per_tick = [] {
+        // Calibrate over the program's lifetime so far, waiting until it is long enough to be accurate
+        const std::chrono::milliseconds MIN_INTERVAL(20);
+        std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start_time;
+        if (elapsed < MIN_INTERVAL) {
+            std::this_thread::sleep_for(MIN_INTERVAL - elapsed);
+        }
+        uint64_t ticks = now() - start_ticks;
+        elapsed = std::chrono::steady_clock::now() - start_time;
+        return std::chrono::duration<double, std::nano>(elapsed).count() / ticks;
+    }();
+    return ns_per_tick;
+#else
+    return 1.0;
+#endif
+}
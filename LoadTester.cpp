@@ -0,0 +1,112 @@
+/**
+ * @file LoadTester.cpp
+ * @brief This file contains the implementation of the LoadTester class, an open-loop load driver for Kitchen.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "LoadTester.hpp"
+#include <chrono>  // For std::chrono::steady_clock
+#include <cmath>   // For std::log
+#include <iomanip> // For std::setw and std::setprecision
+#include <random>  // For std::mt19937_64
+#include <vector>
+
+/**
+ * @param config The load test configuration.
+ */
+LoadTester::LoadTester(const LoadTestConfig& config) : config_(config), generator_(config.workload) {
+}
+
+/**
+ * @return The latency distributions of every operation issued during the test.
+ * @post Issues rate * duration operations against `kitchen` on the configured schedule.
+ */
+LoadTestResult LoadTester::run(Kitchen& kitchen) {
+    using Clock = std::chrono::steady_clock;
+    LoadTestResult result;
+    if (config_.rate <= 0 || config_.duration <= 0) {
+        return result;
+    }
+
+    // Build the whole schedule up front so generating it never delays a send
+    size_t total = static_cast<size_t>(config_.rate * config_.duration);
+    std::vector<Operation> ops = generator_.batch(total);
+    std::vector<uint64_t> intended(total);
+    std::mt19937_64 arrivals(config_.arrival_seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    double mean_gap_ns = 1e9 / config_.rate;
+    double offset_ns = 0;
+    for (size_t i = 0; i < total; i++) {
+        intended[i] = static_cast<uint64_t>(offset_ns);
+        offset_ns += config_.poisson ? -std::log(1.0 - uniform(arrivals)) * mean_gap_ns : mean_gap_ns;
+    }
+
+    Clock::time_point start = Clock::now();
+    auto sinceStart = [start](Clock::time_point t) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t - start).count());
+    };
+
+    uint64_t now = 0;
+    for (size_t i = 0; i < total; i++) {
+        // Spin until the intended send time; if we are behind, send immediately
+        while (now < intended[i]) {
+            now = sinceStart(Clock::now());
+        }
+        uint64_t sent = now;
+        generator_.apply(kitchen, ops[i]);
+        now = sinceStart(Clock::now());
+
+        result.latency[ops[i].type].record(now - intended[i]);
+        result.service[ops[i].type].record(now - sent);
+        if (sent - intended[i] > result.max_lag) {
+            result.max_lag = sent - intended[i];
+        }
+    }
+    result.issued = total;
+    result.elapsed = now / 1e9;
+    return result;
+}
+
+/**
+ * @post Outputs p50/p99/p99.9/max latency and service time per operation type, in microseconds.
+ */
+void LoadTester::printReport(const LoadTestResult& result, std::ostream& out) {
+    out << "issued " << result.issued << " operations in " << std::fixed << std::setprecision(3)
+        << result.elapsed << " s (" << std::setprecision(0) << result.issued / (result.elapsed > 0 ? result.elapsed : 1)
+        << " ops/s), max schedule lag " << std::setprecision(1) << result.max_lag / 1e3 << " us\n\n";
+
+    out << std::left << std::setw(28) << "operation (us)" << std::right << std::setw(10) << "count"
+        << std::setw(10) << "p50" << std::setw(10) << "p99" << std::setw(10) << "p99.9" << std::setw(10) << "max"
+        << "   | service p50" << std::setw(10) << "p99" << std::setw(10) << "max" << '\n';
+    out << std::setprecision(2);
+    for (int type = 0; type < LoadTestResult::TYPE_COUNT; type++) {
+        const LatencyHistogram& latency = result.latency[type];
+        const LatencyHistogram& service = result.service[type];
+        if (latency.count() == 0) {
+            continue;
+        }
+        out << std::left << std::setw(28) << typeName(type) << std::right << std::setw(10) << latency.count()
+            << std::setw(10) << latency.valueAtPercentile(50) / 1e3
+            << std::setw(10) << latency.valueAtPercentile(99) / 1e3
+            << std::setw(10) << latency.valueAtPercentile(99.9) / 1e3
+            << std::setw(10) << latency.max() / 1e3
+            << "   | " << std::setw(11) << service.valueAtPercentile(50) / 1e3
+            << std::setw(10) << service.valueAtPercentile(99) / 1e3
+            << std::setw(10) << service.max() / 1e3 << '\n';
+    }
+}
+
+/**
+ * @return The name of the Kitchen function the operation calls.
+ */
+const char* LoadTester::typeName(int type) {
+    switch (type) {
+        case Operation::NEW_ORDER: return "newOrder";
+        case Operation::SERVE_DISH: return "serveDish";
+        case Operation::RELEASE_BELOW_PREP_TIME: return "releaseDishesBelowPrepTime";
+        case Operation::RELEASE_CUISINE: return "releaseDishesOfCuisineType";
+        default: return "unknown";
+    }
+}
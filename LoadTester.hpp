@@ -0,0 +1,78 @@
+/**
+ * @file LoadTester.hpp
+ * @brief This file contains the declaration of the LoadTester class, an open-loop load driver for Kitchen.
+ *
+ * Operations from a WorkloadGenerator are issued on a fixed arrival schedule (constant rate or
+ * Poisson) that does not wait for earlier operations to finish. Latency is measured from the
+ * intended send time, so time spent queued behind a slow operation is counted rather than hidden
+ * (no coordinated omission). Service time (from actual send to completion) is recorded alongside
+ * for comparison.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef LOAD_TESTER_HPP
+#define LOAD_TESTER_HPP
+
+#include "Histogram.hpp"
+#include "Kitchen.hpp"
+#include "Workload.hpp"
+#include <cstdint>
+#include <iostream>
+
+/**
+ * Configuration of a load test.
+ */
+struct LoadTestConfig {
+    double rate = 100000;        // Target arrivals per second
+    bool poisson = true;         // Exponential inter-arrival times if true, constant otherwise
+    double duration = 2.0;       // Seconds of arrivals to schedule
+    uint64_t arrival_seed = 7;   // Seed of the Poisson arrival process
+    WorkloadConfig workload;     // Menu and operation mix
+};
+
+/**
+ * Latency distributions recorded by one load test, per operation type (see Operation::Type).
+ */
+struct LoadTestResult {
+    static const int TYPE_COUNT = 4;
+    LatencyHistogram latency[TYPE_COUNT];  // From intended send time to completion
+    LatencyHistogram service[TYPE_COUNT];  // From actual send time to completion
+    uint64_t issued = 0;                   // Operations issued
+    double elapsed = 0;                    // Seconds from the first intended send to the last completion
+    uint64_t max_lag = 0;                  // Largest delay of an actual send behind its schedule, in ns
+};
+
+class LoadTester {
+public:
+    /**
+     * @param config The load test configuration.
+     */
+    explicit LoadTester(const LoadTestConfig& config);
+
+    /**
+     * @param kitchen The kitchen under test.
+     * @return The latency distributions of every operation issued during the test.
+     * @post Issues rate * duration operations against `kitchen` on the configured schedule.
+     */
+    LoadTestResult run(Kitchen& kitchen);
+
+    /**
+     * @param result The result of a load test.
+     * @post Outputs p50/p99/p99.9/max latency and service time per operation type, in microseconds.
+     */
+    static void printReport(const LoadTestResult& result, std::ostream& out);
+
+    /**
+     * @param type An operation type.
+     * @return The name of the Kitchen function the operation calls.
+     */
+    static const char* typeName(int type);
+
+private:
+    LoadTestConfig config_;
+    WorkloadGenerator generator_;
+};
+
+#endif // LOAD_TESTER_HPP
@@ -0,0 +1,332 @@
+/**
+ * @file Metrics.cpp
+ * @brief This file contains the implementation of the MetricsRegistry class, which renders Kitchen
+ * statistics, operation counts and latency histograms in the Prometheus text exposition format.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Metrics.hpp"
+#include "Instrumentation.hpp"
+#include "KitchenLatency.hpp"
+#include <algorithm> // For std::remove_if
+#include <cstdio>    // For std::snprintf, std::rename, std::remove
+#include <fstream>
+#include <sstream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define METRICS_HAVE_UNIX_SOCKETS 1
+#endif
+
+// Upper bounds of the latency histogram buckets, in nanoseconds and as rendered in seconds
+static const uint64_t LATENCY_BOUNDS_NS[] = {100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000,
+                                             100000, 250000, 1000000, 10000000};
+static const char* const LATENCY_BOUNDS_LABEL[] = {"1e-07", "2.5e-07", "5e-07", "1e-06", "2.5e-06",
+                                                   "5e-06", "1e-05", "2.5e-05", "5e-05", "0.0001",
+                                                   "0.00025", "0.001", "0.01"};
+static const int LATENCY_BOUND_COUNT = sizeof(LATENCY_BOUNDS_NS) / sizeof(LATENCY_BOUNDS_NS[0]);
+
+// Writes a sample value; integers are written without a fraction
+static void writeValue(std::ostream& out, double value) {
+    char text[32];
+    std::snprintf(text, sizeof(text), "%.9g", value);
+    out << text;
+}
+
+// Writes a label value with backslash, double quote and newline escaped
+static void writeLabelValue(std::ostream& out, const std::string& value) {
+    out << '"';
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            out << '\\' << c;
+        } else if (c == '\n') {
+            out << "\\n";
+        } else {
+            out << c;
+        }
+    }
+    out << '"';
+}
+
+// Writes the HELP and TYPE lines that start a metric family
+static void writeHeader(std::ostream& out, const char* name, const char* type, const char* help) {
+    out << "# HELP " << name << ' ' << help << "\n# TYPE " << name << ' ' << type << '\n';
+}
+
+/**
+ * @param kitchen A kitchen that outlives the registry (or its removal).
+ * @param name The value of the `kitchen` label on the kitchen's metrics.
+ * @post The kitchen's statistics are included in every rendering.
+ */
+void MetricsRegistry::addKitchen(const Kitchen& kitchen, const std::string& name) {
+    kitchens_.emplace_back(name, &kitchen);
+}
+
+/**
+ * @param kitchen A registered kitchen.
+ * @post The kitchen's statistics are no longer rendered.
+ */
+void MetricsRegistry::removeKitchen(const Kitchen& kitchen) {
+    kitchens_.erase(std::remove_if(kitchens_.begin(), kitchens_.end(),
+                                   [&](const std::pair<std::string, const Kitchen*>& entry) {
+                                       return entry.second == &kitchen;
+                                   }),
+                    kitchens_.end());
+}
+
+/**
+ * @post Outputs every metric in the Prometheus text exposition format (version 0.0.4).
+ */
+void MetricsRegistry::render(std::ostream& out) const {
+    // Kitchen statistics: one sample per registered kitchen, each an O(1) read of a maintained aggregate
+    struct Gauge {
+        const char* name;
+        const char* help;
+        double (*read)(const Kitchen&);
+    };
+    static const Gauge GAUGES[] = {
+        {"kitchen_dishes", "Number of dishes in the kitchen.",
+         [](const Kitchen& k) { return static_cast<double>(k.getCurrentSize()); }},
+        {"kitchen_prep_time_sum_minutes", "Sum of the preparation times of the dishes in the kitchen.",
+         [](const Kitchen& k) { return static_cast<double>(k.getPrepTimeSum()); }},
+        {"kitchen_avg_prep_time_minutes", "Average preparation time, rounded to the nearest minute.",
+         [](const Kitchen& k) { return static_cast<double>(k.calculateAvgPrepTime()); }},
+        {"kitchen_elaborate_dishes", "Number of elaborate dishes (5+ ingredients, 60+ minutes).",
+         [](const Kitchen& k) { return static_cast<double>(k.elaborateDishCount()); }},
+        {"kitchen_elaborate_percent", "Percentage of the dishes that are elaborate.",
+         [](const Kitchen& k) { return k.calculateElaboratePercentage(); }},
+    };
+    for (const Gauge& gauge : GAUGES) {
+        writeHeader(out, gauge.name, "gauge", gauge.help);
+        for (const auto& entry : kitchens_) {
+            out << gauge.name << "{kitchen=";
+            writeLabelValue(out, entry.first);
+            out << "} ";
+            writeValue(out, gauge.read(*entry.second));
+            out << '\n';
+        }
+    }
+
+    writeHeader(out, "kitchen_cuisine_dishes", "gauge", "Number of dishes in the kitchen of each cuisine type.");
+    for (const auto& entry : kitchens_) {
+        for (int type = Dish::CuisineType::ITALIAN; type <= Dish::CuisineType::OTHER; type++) {
+            out << "kitchen_cuisine_dishes{kitchen=";
+            writeLabelValue(out, entry.first);
+            out << ",cuisine=\"" << Dish::cuisineName(static_cast<Dish::CuisineType>(type)) << "\"} "
+                << entry.second->cuisineCount(static_cast<Dish::CuisineType>(type)) << '\n';
+        }
+    }
+
+    // Operation counts and latencies, process-wide
+    LatencyHistogram histograms[KitchenLatency::OP_COUNT];
+    for (int op = 0; op < KitchenLatency::OP_COUNT; op++) {
+        histograms[op] = KitchenLatency::snapshot(static_cast<KitchenLatency::Op>(op));
+    }
+
+    writeHeader(out, "kitchen_operations_total", "counter", "Kitchen operations completed, by function.");
+    for (int op = 0; op < KitchenLatency::OP_COUNT; op++) {
+        out << "kitchen_operations_total{op=\"" << KitchenLatency::opName(op) << "\"} "
+            << KitchenLatency::callCount(static_cast<KitchenLatency::Op>(op)) << '\n';
+    }
+
+    // Sampled: each timed call stands for the calls since the previous sample, so the counts are estimates
+    writeHeader(out, "kitchen_operation_duration_seconds", "histogram",
+                "Service time of Kitchen operations, by function, sampled.");
+    for (int op = 0; op < KitchenLatency::OP_COUNT; op++) {
+        const LatencyHistogram& histogram = histograms[op];
+        const char* name = KitchenLatency::opName(op);
+
+        // A recorded bucket counts toward every bound at or above its largest value
+        uint64_t cumulative[LATENCY_BOUND_COUNT] = {};
+        for (int i = 0; i < LatencyHistogram::BUCKET_COUNT; i++) {
+            uint64_t count = histogram.bucketCount(i);
+            if (count == 0) {
+                continue;
+            }
+            uint64_t upper = LatencyHistogram::bucketUpperBound(i);
+            for (int bound = 0; bound < LATENCY_BOUND_COUNT; bound++) {
+                if (upper <= LATENCY_BOUNDS_NS[bound]) {
+                    cumulative[bound] += count;
+                }
+            }
+        }
+        for (int bound = 0; bound < LATENCY_BOUND_COUNT; bound++) {
+            out << "kitchen_operation_duration_seconds_bucket{op=\"" << name << "\",le=\""
+                << LATENCY_BOUNDS_LABEL[bound] << "\"} " << cumulative[bound] << '\n';
+        }
+        out << "kitchen_operation_duration_seconds_bucket{op=\"" << name << "\",le=\"+Inf\"} "
+            << histogram.count() << '\n';
+        out << "kitchen_operation_duration_seconds_sum{op=\"" << name << "\"} ";
+        writeValue(out, histogram.mean() * histogram.count() / 1e9);
+        out << "\nkitchen_operation_duration_seconds_count{op=\"" << name << "\"} " << histogram.count() << '\n';
+    }
+
+    // Operation counters, only when compiled in
+    if (OpCounters::enabled()) {
+        OpCounterSnapshot counters = OpCounters::snapshot();
+        struct Counter {
+            const char* name;
+            const char* help;
+            uint64_t value;
+        };
+        const Counter COUNTERS[] = {
+            {"kitchen_dish_compares_total", "Calls of Dish::operator==.", counters.dish_compares},
+            {"kitchen_dish_copies_total", "Dish copy constructions and assignments.", counters.dish_copies},
+            {"kitchen_dish_moves_total", "Dish move constructions and assignments.", counters.dish_moves},
+            {"kitchen_slots_scanned_total", "Slots examined by Kitchen::findDish while looking up a dish.",
+             counters.slots_scanned},
+            {"kitchen_elements_shifted_total", "Dishes moved by Kitchen::removeSlot and shiftSlot to fill a removed slot.",
+             counters.elements_shifted},
+        };
+        for (const Counter& counter : COUNTERS) {
+            writeHeader(out, counter.name, "counter", counter.help);
+            out << counter.name << ' ' << counter.value << '\n';
+        }
+        writeHeader(out, "kitchen_method_calls_total", "counter", "Calls of each Kitchen method.");
+        for (int method = 0; method < OpCounterSnapshot::KITCHEN_METHOD_COUNT; method++) {
+            out << "kitchen_method_calls_total{method=\"" << OpCounterSnapshot::methodName(method) << "\"} "
+                << counters.kitchen_calls[method] << '\n';
+        }
+    }
+}
+
+/**
+ * @return Every metric in the Prometheus text exposition format.
+ */
+std::string MetricsRegistry::render() const {
+    std::ostringstream out;
+    render(out);
+    return out.str();
+}
+
+/**
+ * @return True if the metrics were written. The file is replaced atomically.
+ */
+bool MetricsRegistry::writeFile(const std::string& path) const {
+    // Write next to the target and rename over it, so a reader never sees a partial rendering
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary);
+        if (!file) {
+            return false;
+        }
+        render(file);
+        if (!file.flush()) {
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+#ifdef METRICS_HAVE_UNIX_SOCKETS
+// Fills in a Unix socket address; false if the path does not fit
+static bool socketAddress(const std::string& path, sockaddr_un& address) {
+    address = sockaddr_un();
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    path.copy(address.sun_path, path.size());
+    return true;
+}
+#endif
+
+/**
+ * @return True if every connection was answered, false if the socket could not be set up.
+ * @post Each connection receives one fresh rendering and is closed; the socket file is removed.
+ */
+bool MetricsRegistry::serveUnixSocket(const std::string& path, int scrapes,
+                                      const std::function<void()>& between_scrapes) const {
+#ifdef METRICS_HAVE_UNIX_SOCKETS
+    sockaddr_un address;
+    if (!socketAddress(path, address)) {
+        return false;
+    }
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        return false;
+    }
+    unlink(path.c_str());
+    if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 8) != 0) {
+        close(listener);
+        return false;
+    }
+
+#ifdef MSG_NOSIGNAL
+    const int send_flags = MSG_NOSIGNAL; // A scraper that hangs up early must not kill the process
+#else
+    const int send_flags = 0;
+#endif
+    bool answered_all = true;
+    for (int served = 0; served < scrapes; served++) {
+        int connection = accept(listener, nullptr, nullptr);
+        if (connection < 0) {
+            answered_all = false;
+            break;
+        }
+        // Render per connection so every scrape sees current values
+        std::string body = render();
+        size_t sent = 0;
+        while (sent < body.size()) {
+            ssize_t n = send(connection, body.data() + sent, body.size() - sent, send_flags);
+            if (n <= 0) {
+                break;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        close(connection);
+        if (between_scrapes) {
+            between_scrapes();
+        }
+    }
+    close(listener);
+    unlink(path.c_str());
+    return answered_all;
+#else
+    (void)path;
+    (void)scrapes;
+    (void)between_scrapes;
+    return false;
+#endif
+}
+
+/**
+ * @return True if a rendering was read, false otherwise.
+ */
+bool MetricsRegistry::scrapeUnixSocket(const std::string& path, std::string& body) {
+    body.clear();
+#ifdef METRICS_HAVE_UNIX_SOCKETS
+    sockaddr_un address;
+    if (!socketAddress(path, address)) {
+        return false;
+    }
+    int connection = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (connection < 0) {
+        return false;
+    }
+    if (connect(connection, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        close(connection);
+        return false;
+    }
+    // The server writes one rendering and closes the connection
+    char buffer[4096];
+    ssize_t n;
+    while ((n = read(connection, buffer, sizeof(buffer))) > 0) {
+        body.append(buffer, static_cast<size_t>(n));
+    }
+    close(connection);
+    return n == 0 && !body.empty();
+#else
+    (void)path;
+    return false;
+#endif
+}
@@ -0,0 +1,81 @@
+/**
+ * @file Metrics.hpp
+ * @brief This file contains the declaration of the MetricsRegistry class, which renders Kitchen
+ * statistics, operation counts and latency histograms in the Prometheus text exposition format.
+ *
+ * Every Kitchen statistic is read from the aggregates Kitchen maintains on each change, so rendering
+ * takes the same time however many dishes there are. Operation counts and latencies come from the
+ * KitchenLatency call counters and sampled histograms and cover every Kitchen in the process; the
+ * OpCounters totals are added when the program is compiled with KITCHEN_INSTRUMENT.
+ *
+ * The registry reads registered kitchens without locking, so render from the thread that changes
+ * them (or while they are not being changed).
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include "Kitchen.hpp"
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class MetricsRegistry {
+public:
+    /**
+     * @param kitchen A kitchen that outlives the registry (or its removal).
+     * @param name The value of the `kitchen` label on the kitchen's metrics.
+     * @post The kitchen's statistics are included in every rendering.
+     */
+    void addKitchen(const Kitchen& kitchen, const std::string& name);
+
+    /**
+     * @param kitchen A registered kitchen.
+     * @post The kitchen's statistics are no longer rendered.
+     */
+    void removeKitchen(const Kitchen& kitchen);
+
+    /**
+     * @post Outputs every metric in the Prometheus text exposition format (version 0.0.4).
+     */
+    void render(std::ostream& out) const;
+
+    /**
+     * @return Every metric in the Prometheus text exposition format.
+     */
+    std::string render() const;
+
+    /**
+     * @param path The file a scraper reads (e.g. for the node exporter's textfile collector).
+     * @return True if the metrics were written. The file is replaced atomically, so a reader never
+     * sees a partial rendering.
+     */
+    bool writeFile(const std::string& path) const;
+
+    /**
+     * @param path The path of the Unix domain socket to listen on; an existing file there is replaced.
+     * @param scrapes The number of connections to answer before returning.
+     * @param between_scrapes Called after each answered connection (may be empty), e.g. to advance
+     * the workload between scrapes on the same thread.
+     * @return True if every connection was answered, false if the socket could not be set up.
+     * @post Each connection receives one fresh rendering and is closed; the socket file is removed.
+     */
+    bool serveUnixSocket(const std::string& path, int scrapes,
+                         const std::function<void()>& between_scrapes = nullptr) const;
+
+    /**
+     * @param path The path of a socket served by serveUnixSocket.
+     * @param body Where to store the rendering.
+     * @return True if a rendering was read, false otherwise.
+     */
+    static bool scrapeUnixSocket(const std::string& path, std::string& body);
+
+private:
+    std::vector<std::pair<std::string, const Kitchen*>> kitchens_;
+};
+
+#endif // METRICS_HPP
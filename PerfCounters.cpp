@@ -0,0 +1,175 @@
+/**
+ * @file PerfCounters.cpp
+ * @brief This file contains the implementation of the PerfCounters class, a thin wrapper over Linux
+ * perf_event_open that counts hardware events for the calling thread.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "PerfCounters.hpp"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>             // For std::memset, std::strerror
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+/**
+ * Default constructor.
+ * @post Opens every event for the calling thread, disabled.
+ */
+PerfCounters::PerfCounters() {
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        fds_[i] = -1;
+    }
+
+#ifdef __linux__
+    const uint64_t L1D_READ_MISS = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    const uint32_t types[EVENT_COUNT] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+                                         PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE};
+    const uint64_t configs[EVENT_COUNT] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, L1D_READ_MISS,
+                                           PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = types[i];
+        attr.config = configs[i];
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // This thread, any CPU, no group
+        fds_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fds_[i] < 0) {
+            unavailable_reason_ += std::string(unavailable_reason_.empty() ? "" : "; ") + eventName(i) + ": " +
+                                   std::strerror(errno);
+        }
+    }
+#else
+    unavailable_reason_ = "perf_event_open is only available on Linux";
+#endif
+}
+
+/**
+ * @post Closes every open event.
+ */
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        if (fds_[i] >= 0) {
+            close(fds_[i]);
+        }
+    }
+#endif
+}
+
+/**
+ * @return True if at least one event could be opened.
+ */
+bool PerfCounters::available() const {
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        if (fds_[i] >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @return True if the event could be opened.
+ */
+bool PerfCounters::available(Event event) const {
+    return fds_[event] >= 0;
+}
+
+/**
+ * @return A description of why events are unavailable, or an empty string if all are available.
+ */
+const std::string& PerfCounters::unavailableReason() const {
+    return unavailable_reason_;
+}
+
+/**
+ * @post Every open event counts until stop() is called.
+ */
+void PerfCounters::start() {
+#ifdef __linux__
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        if (fds_[i] >= 0) {
+            ioctl(fds_[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+/**
+ * @post Every open event stops counting; counts accumulate across start()/stop() pairs.
+ */
+void PerfCounters::stop() {
+#ifdef __linux__
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        if (fds_[i] >= 0) {
+            ioctl(fds_[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+#endif
+}
+
+/**
+ * @post Every open event is zero.
+ */
+void PerfCounters::reset() {
+#ifdef __linux__
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        if (fds_[i] >= 0) {
+            ioctl(fds_[i], PERF_EVENT_IOC_RESET, 0);
+        }
+    }
+#endif
+}
+
+/**
+ * @return The counts accumulated since the last reset().
+ */
+PerfCounters::Reading PerfCounters::read() const {
+    Reading reading;
+#ifdef __linux__
+    for (int i = 0; i < EVENT_COUNT; i++) {
+        uint64_t data[3]; // value, time enabled, time running
+        if (fds_[i] < 0 || ::read(fds_[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) {
+            continue;
+        }
+        if (data[2] == 0) {
+            // Enabled but never scheduled on the hardware: no information
+            reading.valid[i] = data[1] == 0;
+            continue;
+        }
+        reading.values[i] = data[2] < data[1] ? static_cast<uint64_t>(static_cast<double>(data[0]) * data[1] / data[2])
+                                              : data[0];
+        reading.valid[i] = true;
+    }
+#endif
+    return reading;
+}
+
+/**
+ * @return The name of the event, as used in the benchmark output.
+ */
+const char* PerfCounters::eventName(int event) {
+    switch (event) {
+        case CYCLES: return "cycles";
+        case INSTRUCTIONS: return "instructions";
+        case L1D_READ_MISSES: return "l1d_read_misses";
+        case LLC_MISSES: return "llc_misses";
+        case BRANCH_MISSES: return "branch_misses";
+        default: return "unknown";
+    }
+}
@@ -0,0 +1,95 @@
+/**
+ * @file PerfCounters.hpp
+ * @brief This file contains the declaration of the PerfCounters class, a thin wrapper over Linux
+ * perf_event_open that counts hardware events for the calling thread.
+ *
+ * The counters measure cycles, instructions, L1 data cache read misses, last-level cache misses and
+ * branch misses, in user space only. Each event is opened separately, so an event the CPU, the
+ * kernel or the permissions (kernel.perf_event_paranoid) do not allow is simply reported as
+ * unavailable while the others keep working. On other platforms every event is unavailable.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <cstdint>
+#include <string>
+
+class PerfCounters {
+public:
+    enum Event { CYCLES, INSTRUCTIONS, L1D_READ_MISSES, LLC_MISSES, BRANCH_MISSES, EVENT_COUNT };
+
+    /**
+     * Counter values, scaled up when the kernel had to multiplex the hardware counters.
+     */
+    struct Reading {
+        uint64_t values[EVENT_COUNT] = {};
+        bool valid[EVENT_COUNT] = {};
+    };
+
+    /**
+     * Default constructor.
+     * @post Opens every event for the calling thread, disabled. Events that cannot be opened are
+     * marked unavailable and the reason is kept for unavailableReason().
+     */
+    PerfCounters();
+
+    /**
+     * @post Closes every open event.
+     */
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /**
+     * @return True if at least one event could be opened.
+     */
+    bool available() const;
+
+    /**
+     * @param event An event.
+     * @return True if the event could be opened.
+     */
+    bool available(Event event) const;
+
+    /**
+     * @return A description of why events are unavailable, or an empty string if all are available.
+     */
+    const std::string& unavailableReason() const;
+
+    /**
+     * @post Every open event counts until stop() is called.
+     */
+    void start();
+
+    /**
+     * @post Every open event stops counting; counts accumulate across start()/stop() pairs.
+     */
+    void stop();
+
+    /**
+     * @post Every open event is zero.
+     */
+    void reset();
+
+    /**
+     * @return The counts accumulated since the last reset().
+     */
+    Reading read() const;
+
+    /**
+     * @param event An event.
+     * @return The name of the event, as used in the benchmark output.
+     */
+    static const char* eventName(int event);
+
+private:
+    int fds_[EVENT_COUNT];
+    std::string unavailable_reason_;
+};
+
+#endif // PERF_COUNTERS_HPP
@@ -0,0 +1,111 @@
+/**
+ * @file ThreadPool.cpp
+ * @brief This file contains the implementation of the ThreadPool class, a fixed set of worker threads
+ * that run data-parallel loops over index ranges.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "ThreadPool.hpp"
+#include <algorithm> // For std::min
+
+/**
+ * @param threads The number of threads that run a loop, counting the calling thread; 0 means one per
+ * hardware thread.
+ */
+ThreadPool::ThreadPool(int threads)
+    : generation_(0), stopping_(false), busy_workers_(0), body_(nullptr), count_(0), grain_(1), next_chunk_(0) {
+    if (threads <= 0) {
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    for (int i = 1; i < threads; i++) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+/**
+ * @post Stops and joins the workers.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_ready_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+/**
+ * @return The number of threads that run a loop, counting the calling thread.
+ */
+int ThreadPool::size() const {
+    return static_cast<int>(workers_.size()) + 1;
+}
+
+/**
+ * @post body(begin, end) has run for every chunk of [0, count).
+ */
+void ThreadPool::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    grain = grain == 0 ? 1 : grain;
+    // A single chunk, or no workers: not worth waking anyone
+    if (count <= grain || workers_.empty()) {
+        for (size_t begin = 0; begin < count; begin += grain) {
+            body(begin, std::min(begin + grain, count));
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        body_ = &body;
+        count_ = count;
+        grain_ = grain;
+        next_chunk_.store(0, std::memory_order_relaxed);
+        busy_workers_ = static_cast<int>(workers_.size());
+        generation_++;
+    }
+    work_ready_.notify_all();
+
+    runChunks();
+
+    // The loop's state must outlive every worker that may still be reading it
+    std::unique_lock<std::mutex> lock(mutex_);
+    work_done_.wait(lock, [this] { return busy_workers_ == 0; });
+    body_ = nullptr;
+}
+
+// Waits for loops and runs their chunks, until the pool stops
+void ThreadPool::workerLoop() {
+    uint64_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_ready_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) {
+                return;
+            }
+            seen_generation = generation_;
+        }
+
+        runChunks();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--busy_workers_ == 0) {
+            work_done_.notify_one();
+        }
+    }
+}
+
+// Takes chunks of the current loop until none are left
+void ThreadPool::runChunks() {
+    size_t chunks = (count_ + grain_ - 1) / grain_;
+    for (size_t chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed); chunk < chunks;
+         chunk = next_chunk_.fetch_add(1, std::memory_order_relaxed)) {
+        size_t begin = chunk * grain_;
+        (*body_)(begin, std::min(begin + grain_, count_));
+    }
+}
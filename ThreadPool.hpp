@@ -0,0 +1,110 @@
+/**
+ * @file ThreadPool.hpp
+ * @brief This file contains the declaration of the ThreadPool class, a fixed set of worker threads
+ * that run data-parallel loops over index ranges.
+ *
+ * A loop of `count` indices is cut into chunks of `grain` indices. The workers and the calling
+ * thread take chunks from a shared atomic counter until none are left, so uneven chunks balance
+ * themselves, and the call returns when every chunk is done. parallelReduce computes one partial
+ * result per chunk and combines the partials in chunk order, so its result does not depend on the
+ * number of threads or on scheduling.
+ *
+ * One loop runs at a time; a loop body must not start another loop on the same pool, and must not
+ * throw.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    /**
+     * @param threads The number of threads that run a loop, counting the calling thread; 0 means
+     * one per hardware thread.
+     * @post Starts threads - 1 workers, which sleep until a loop is submitted.
+     */
+    explicit ThreadPool(int threads = 0);
+
+    /**
+     * @post Stops and joins the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @return The number of threads that run a loop, counting the calling thread.
+     */
+    int size() const;
+
+    /**
+     * @param count The number of indices.
+     * @param grain The number of indices per chunk (at least 1).
+     * @param body Called as body(begin, end) once for every chunk [begin, end) of [0, count),
+     * from any of the threads.
+     * @post Every chunk has been processed.
+     */
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+    /**
+     * @param count The number of indices.
+     * @param grain The number of indices per chunk (at least 1).
+     * @param identity The result of an empty range.
+     * @param map Called as map(begin, end) for every chunk; returns the chunk's partial result.
+     * @param combine Called as combine(total, partial); returns their combination.
+     * @return The partials of all chunks combined, in chunk order, starting from identity.
+     */
+    template <typename T, typename Map, typename Combine>
+    T parallelReduce(size_t count, size_t grain, T identity, Map map, Combine combine);
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex submit_mutex_; // Held for a whole loop, so loops from different threads take turns
+    std::mutex mutex_;        // Guards the fields below
+    std::condition_variable work_ready_;
+    std::condition_variable work_done_;
+    uint64_t generation_;     // Bumped for every loop, so a worker sees each loop once
+    bool stopping_;
+    int busy_workers_;        // Workers still running chunks of the current loop
+
+    // The current loop; only read while a loop runs
+    const std::function<void(size_t, size_t)>* body_;
+    size_t count_;
+    size_t grain_;
+    std::atomic<size_t> next_chunk_;
+
+    // Waits for loops and runs their chunks, until the pool stops
+    void workerLoop();
+
+    // Takes chunks of the current loop until none are left
+    void runChunks();
+};
+
+// ********* INLINE FUNCTIONS **************//
+
+template <typename T, typename Map, typename Combine>
+T ThreadPool::parallelReduce(size_t count, size_t grain, T identity, Map map, Combine combine) {
+    grain = grain == 0 ? 1 : grain;
+    std::vector<T> partials((count + grain - 1) / grain, identity);
+    parallelFor(count, grain, [&](size_t begin, size_t end) { partials[begin / grain] = map(begin, end); });
+    T total = identity;
+    for (const T& partial : partials) {
+        total = combine(total, partial);
+    }
+    return total;
+}
+
+#endif // THREAD_POOL_HPP
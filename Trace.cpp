@@ -0,0 +1,207 @@
+/**
+ * @file Trace.cpp
+ * @brief This file contains the implementation of the Trace class, lightweight timeline tracing that
+ * exports Chrome trace event JSON (chrome://tracing, Perfetto).
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Trace.hpp"
+#include <chrono>  // For std::chrono::steady_clock
+#include <iomanip> // For std::setprecision
+#include <mutex>
+
+// One thread's events. A buffer with events outlives its thread so that they can still be exported.
+struct TraceBuffer {
+    Trace::Event events[Trace::BUFFER_EVENTS];
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint64_t> dropped{0};
+    int thread_id = 0;
+    bool retired = false; // Its thread has exited; guarded by registry_mutex
+    TraceBuffer* next = nullptr;
+};
+
+static std::mutex registry_mutex;
+static TraceBuffer* registry_head = nullptr;
+static int next_thread_id = 1;
+static thread_local TraceBuffer* local_buffer = nullptr;
+static thread_local bool thread_exiting = false;
+
+// Unlinks a buffer from the registry and frees it; the caller holds registry_mutex
+static void freeBuffer(TraceBuffer* buffer) {
+    TraceBuffer** link = &registry_head;
+    while (*link != buffer) {
+        link = &(*link)->next;
+    }
+    *link = buffer->next;
+    delete buffer;
+}
+
+// Owns the calling thread's buffer: registers it on creation, retires it when the thread exits
+struct BufferOwner {
+    TraceBuffer* buffer;
+
+    BufferOwner() : buffer(new TraceBuffer) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        buffer->thread_id = next_thread_id++;
+        buffer->next = registry_head;
+        registry_head = buffer;
+    }
+
+    ~BufferOwner() {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        if (buffer->count.load(std::memory_order_relaxed) == 0 &&
+            buffer->dropped.load(std::memory_order_relaxed) == 0) {
+            freeBuffer(buffer);
+        } else {
+            buffer->retired = true; // Freed by clear() once its events are no longer wanted
+        }
+
+        // Spans that end later in this thread's shutdown are not recorded
+        local_buffer = nullptr;
+        thread_exiting = true;
+    }
+};
+
+// Returns nullptr once the thread has started exiting
+static TraceBuffer* registerThread() {
+    if (thread_exiting) {
+        return nullptr;
+    }
+    thread_local BufferOwner owner;
+    local_buffer = owner.buffer;
+    return owner.buffer;
+}
+
+/**
+ * @param on True to start recording spans, false to stop.
+ */
+void Trace::setEnabled(bool on) {
+    enabled_.store(on, std::memory_order_relaxed);
+}
+
+/**
+ * @return The current time on the trace clock, in nanoseconds.
+ */
+uint64_t Trace::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+ * @post The event is appended to the calling thread's buffer, or counted as dropped if it is full.
+ */
+void Trace::record(const Event& event) {
+    TraceBuffer* local = local_buffer != nullptr ? local_buffer : registerThread();
+    if (local == nullptr) {
+        return;
+    }
+    TraceBuffer& buffer = *local;
+    uint32_t count = buffer.count.load(std::memory_order_relaxed);
+    if (count == BUFFER_EVENTS) {
+        buffer.dropped.store(buffer.dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    buffer.events[count] = event;
+    // Publish the event: a reader that sees the new count also sees the event
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+// Writes a string as a JSON string literal
+static void writeJsonString(std::ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            out << '\\';
+        }
+        out << *c;
+    }
+    out << '"';
+}
+
+/**
+ * @post Outputs every recorded event of every thread in Chrome trace event JSON format.
+ */
+void Trace::writeJson(std::ostream& out) {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+
+    // Timestamps are relative to the earliest event so the viewer opens at the start of the trace
+    uint64_t origin = UINT64_MAX;
+    for (TraceBuffer* buffer = registry_head; buffer != nullptr; buffer = buffer->next) {
+        uint32_t count = buffer->count.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; i++) {
+            if (buffer->events[i].start_ns < origin) {
+                origin = buffer->events[i].start_ns;
+            }
+        }
+    }
+
+    // The caller's stream keeps its own format; only the timestamps below are written fixed to 3 places
+    std::ios_base::fmtflags saved_flags = out.flags();
+    std::streamsize saved_precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+    out << "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [";
+    bool first = true;
+    for (TraceBuffer* buffer = registry_head; buffer != nullptr; buffer = buffer->next) {
+        uint32_t count = buffer->count.load(std::memory_order_acquire);
+        for (uint32_t i = 0; i < count; i++) {
+            const Event& event = buffer->events[i];
+            out << (first ? "\n" : ",\n") << "{\"name\": ";
+            writeJsonString(out, event.name);
+            out << ", \"cat\": \"kitchen\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << buffer->thread_id
+                << ", \"ts\": " << (event.start_ns - origin) / 1e3 << ", \"dur\": " << event.duration_ns / 1e3;
+            if (event.arg >= 0) {
+                out << ", \"args\": {\"n\": " << event.arg << '}';
+            }
+            out << '}';
+            first = false;
+        }
+    }
+    out << "\n]}\n";
+    out.flags(saved_flags);
+    out.precision(saved_precision);
+}
+
+/**
+ * @return The number of events dropped because a thread's buffer was full.
+ */
+uint64_t Trace::dropped() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    uint64_t total = 0;
+    for (TraceBuffer* buffer = registry_head; buffer != nullptr; buffer = buffer->next) {
+        total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+/**
+ * @post Every buffer is empty, and the buffers of exited threads are freed. Must not run while other
+ * threads are recording.
+ */
+void Trace::clear() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    TraceBuffer* buffer = registry_head;
+    while (buffer != nullptr) {
+        TraceBuffer* next = buffer->next;
+        if (buffer->retired) {
+            freeBuffer(buffer);
+        } else {
+            buffer->count.store(0, std::memory_order_relaxed);
+            buffer->dropped.store(0, std::memory_order_relaxed);
+        }
+        buffer = next;
+    }
+}
+
+/**
+ * @return The number of buffers held.
+ */
+size_t Trace::bufferCount() {
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    size_t count = 0;
+    for (TraceBuffer* buffer = registry_head; buffer != nullptr; buffer = buffer->next) {
+        count++;
+    }
+    return count;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file Trace.hpp
+ * @brief This file contains the declaration of the Trace class, lightweight timeline tracing that
+ * exports Chrome trace event JSON (chrome://tracing, Perfetto).
+ *
+ * TRACE_SCOPE("name") records a complete ("X") event covering the rest of the enclosing scope. Each
+ * thread appends events to its own fixed-size buffer: the owning thread is the only writer and
+ * publishes each event with a release store of the event count, so recording takes no lock and the
+ * exporter can read while threads keep tracing. When a buffer is full further events of that thread
+ * are dropped and counted. A buffer is allocated on the thread's first event. When the thread exits
+ * its buffer is freed at once if it holds no events; otherwise it is kept for export until clear().
+ *
+ * While tracing is disabled (the default) a span reads the tracing state once: one relaxed load and
+ * one predictable branch on entry, which also skips evaluating TRACE_SCOPE_N's argument. On exit
+ * the span tests whether it was started, a compare of its own member, to skip recording.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+// Records the rest of the enclosing scope as a span; `name` must be a string literal
+#define TRACE_SCOPE(name) \
+    TraceSpan TRACE_CONCAT(trace_span_, __LINE__)(Trace::enabled() ? TraceSpan::start(name) : TraceSpan())
+
+// Same as TRACE_SCOPE, with an integer argument shown as "n" in the trace viewer. `n` is evaluated
+// only while tracing is enabled.
+#define TRACE_SCOPE_N(name, n)                        \
+    TraceSpan TRACE_CONCAT(trace_span_, __LINE__)(    \
+        Trace::enabled() ? TraceSpan::start(name, static_cast<int64_t>(n)) : TraceSpan())
+
+class Trace {
+public:
+    static const int BUFFER_EVENTS = 1 << 16; // Events kept per thread
+
+    /**
+     * One complete event.
+     */
+    struct Event {
+        const char* name;
+        uint64_t start_ns;
+        uint64_t duration_ns;
+        int64_t arg;
+    };
+
+    /**
+     * @return True if spans are currently being recorded.
+     */
+    static inline bool enabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @param on True to start recording spans, false to stop.
+     */
+    static void setEnabled(bool on);
+
+    /**
+     * @return The current time on the trace clock, in nanoseconds.
+     */
+    static uint64_t now();
+
+    /**
+     * @param event A finished span.
+     * @post The event is appended to the calling thread's buffer, or counted as dropped if it is full.
+     */
+    static void record(const Event& event);
+
+    /**
+     * @post Outputs every recorded event of every thread in Chrome trace event JSON format.
+     */
+    static void writeJson(std::ostream& out);
+
+    /**
+     * @return The number of events dropped because a thread's buffer was full.
+     */
+    static uint64_t dropped();
+
+    /**
+     * @post Every buffer is empty, and the buffers of exited threads are freed. Must not run while
+     * other threads are recording.
+     */
+    static void clear();
+
+    /**
+     * @return The number of buffers held: one per live thread that has recorded an event, plus one
+     * per exited thread whose events have not been cleared.
+     */
+    static size_t bufferCount();
+
+private:
+    static inline std::atomic<bool> enabled_{false};
+};
+
+/**
+ * Records the lifetime of the enclosing scope when tracing is enabled. Use TRACE_SCOPE, which
+ * tests Trace::enabled() once and picks start() or the empty span.
+ */
+class TraceSpan {
+public:
+    /**
+     * A span that records nothing.
+     */
+    inline TraceSpan() : name_(nullptr), start_(0), arg_(-1) {
+    }
+
+    /**
+     * @param name The name of the span; must be a string literal.
+     * @param arg An integer shown as "n" in the trace viewer, or -1 for none.
+     * @return A span started now. Returned by value through guaranteed copy elision.
+     */
+    static inline TraceSpan start(const char* name, int64_t arg = -1) {
+        return TraceSpan(name, Trace::now(), arg);
+    }
+
+    inline ~TraceSpan() {
+        if (name_ != nullptr) {
+            Trace::record({name_, start_, Trace::now() - start_, arg_});
+        }
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    inline TraceSpan(const char* name, uint64_t start, int64_t arg) : name_(name), start_(start), arg_(arg) {
+    }
+
+    const char* name_;
+    uint64_t start_;
+    int64_t arg_;
+};
+
+#endif // TRACE_HPP
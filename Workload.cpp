@@ -0,0 +1,265 @@
+/**
+ * @file Workload.cpp
+ * @brief This file contains the implementation of the WorkloadGenerator class, a deterministic, seedable
+ * generator of synthetic menus and Kitchen operation streams.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Workload.hpp"
+#include "Trace.hpp"
+#include <algorithm> // For std::min and std::max
+#include <cmath>     // For std::pow, std::sqrt, std::log, std::cos
+#include <cstring>   // For std::memcmp
+#include <fstream>
+
+static const char* const ADJECTIVES[] = {
+    "Spicy", "Smoked", "Roasted", "Grilled", "Braised", "Crispy", "Creamy", "Garlic",
+    "Honey", "Lemon", "Pepper", "Sweet", "Golden", "Rustic", "Classic", "Fresh"};
+static const char* const BASES[] = {
+    "Chicken", "Noodles", "Curry", "Tacos", "Risotto", "Burger", "Salmon", "Dumplings",
+    "Lasagna", "Ramen", "Stew", "Salad", "Pizza", "Burrito", "Omelette", "Tofu",
+    "Gnocchi", "Paella", "Quiche", "Chili"};
+static const char* const INGREDIENTS[] = {
+    "Tomato", "Onion", "Garlic", "Basil", "Beef", "Chicken", "Rice", "Beans", "Cheese",
+    "Flour", "Butter", "Cream", "Potatoes", "Carrots", "Ginger", "Soy Sauce", "Cilantro",
+    "Lime", "Chili Pepper", "Olive Oil", "Mushrooms", "Spinach", "Eggs", "Tortilla",
+    "Coconut Milk", "Shrimp", "Pork", "Lentils", "Parsley", "Thyme", "Paprika", "Noodles"};
+static const int NUM_ADJECTIVES = sizeof(ADJECTIVES) / sizeof(ADJECTIVES[0]);
+static const int NUM_BASES = sizeof(BASES) / sizeof(BASES[0]);
+static const int NUM_INGREDIENTS = sizeof(INGREDIENTS) / sizeof(INGREDIENTS[0]);
+
+static const char FILE_MAGIC[8] = {'K', 'W', 'O', 'R', 'K', 'L', 'D', '1'};
+
+// Builds a unique dish name (letters and spaces only) from a menu index
+static std::string menuName(int index) {
+    std::string name = ADJECTIVES[index % NUM_ADJECTIVES];
+    name += ' ';
+    name += BASES[(index / NUM_ADJECTIVES) % NUM_BASES];
+    int round = index / (NUM_ADJECTIVES * NUM_BASES);
+    if (round > 0) {
+        name += ' ';
+        while (round > 0) {
+            name += static_cast<char>('A' + round % 26);
+            round /= 26;
+        }
+    }
+    return name;
+}
+
+// Converts a probability in [0, 1] to a threshold on a uniform 64-bit random number
+static uint64_t cutoff(double probability) {
+    if (probability >= 1.0) {
+        return UINT64_MAX;
+    }
+    if (probability <= 0.0) {
+        return 0;
+    }
+    return static_cast<uint64_t>(static_cast<long double>(probability) * 18446744073709551616.0L);
+}
+
+// Builds a Vose alias table for the given weights; thresholds are in units of 2^-32
+static void buildAliasTable(const std::vector<double>& weights, std::vector<uint32_t>& alias,
+                            std::vector<uint64_t>& threshold) {
+    size_t count = weights.size();
+    alias.assign(count, 0);
+    threshold.assign(count, 1ULL << 32);
+
+    double total = 0;
+    for (double weight : weights) {
+        total += std::max(weight, 0.0);
+    }
+    if (count == 0 || total <= 0) {
+        return;
+    }
+
+    std::vector<double> scaled(count);
+    std::vector<uint32_t> small, large;
+    for (size_t i = 0; i < count; i++) {
+        scaled[i] = std::max(weights[i], 0.0) * count / total;
+        (scaled[i] < 1.0 ? small : large).push_back(static_cast<uint32_t>(i));
+    }
+    while (!small.empty() && !large.empty()) {
+        uint32_t less = small.back();
+        small.pop_back();
+        uint32_t more = large.back();
+        threshold[less] = static_cast<uint64_t>(scaled[less] * 4294967296.0);
+        alias[less] = more;
+        scaled[more] -= 1.0 - scaled[less];
+        if (scaled[more] < 1.0) {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+    // Anything left over is (up to rounding) exactly 1 and never uses its alias
+}
+
+/**
+ * @param config The workload configuration.
+ * @post Builds the menu and the samplers. The same config always yields the same menu and stream.
+ */
+WorkloadGenerator::WorkloadGenerator(const WorkloadConfig& config)
+    : state_(config.seed), recent_(), recent_count_(0) {
+    int menu_size = std::max(config.menu_size, 1);
+
+    std::vector<double> cuisine_weights = config.cuisine_weights;
+    cuisine_weights.resize(Dish::CuisineType::OTHER + 1, 0.0);
+    buildAliasTable(cuisine_weights, cuisine_alias_, cuisine_threshold_);
+
+    // Build the menu
+    int min_ingredients = std::max(config.min_ingredients, 0);
+    int max_ingredients = std::max(config.max_ingredients, min_ingredients);
+    menu_.reserve(menu_size);
+    for (int i = 0; i < menu_size; i++) {
+        std::vector<std::string> ingredients;
+        int ingredient_count = min_ingredients + nextBelow(max_ingredients - min_ingredients + 1);
+        for (int j = 0; j < ingredient_count; j++) {
+            ingredients.push_back(INGREDIENTS[nextBelow(NUM_INGREDIENTS)]);
+        }
+
+        // Box-Muller normal sample from the quick or the slow mode
+        bool slow = (nextRandom() >> 11) * 0x1.0p-53 < config.slow_fraction;
+        double u1 = ((nextRandom() >> 11) + 1) * 0x1.0p-53;
+        double u2 = (nextRandom() >> 11) * 0x1.0p-53;
+        double normal = std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+        double prep = slow ? config.slow_prep_mean + normal * config.slow_prep_stddev
+                           : config.quick_prep_mean + normal * config.quick_prep_stddev;
+        int prep_time = std::max(1, static_cast<int>(std::lround(prep)));
+
+        double price_fraction = (nextRandom() >> 11) * 0x1.0p-53;
+        double price = std::round((config.min_price + price_fraction * (config.max_price - config.min_price)) * 100) / 100;
+
+        uint64_t random = nextRandom();
+        uint32_t column = static_cast<uint32_t>(((random >> 32) * cuisine_alias_.size()) >> 32);
+        int cuisine = (random & 0xFFFFFFFFULL) < cuisine_threshold_[column] ? column : cuisine_alias_[column];
+
+        menu_.push_back(Dish(menuName(i), ingredients, prep_time, price, static_cast<Dish::CuisineType>(cuisine)));
+    }
+
+    // Zipf popularity: menu index i has weight 1 / (i + 1)^s
+    std::vector<double> popularity(menu_size);
+    for (int i = 0; i < menu_size; i++) {
+        popularity[i] = 1.0 / std::pow(i + 1.0, config.zipf_exponent);
+    }
+    buildAliasTable(popularity, alias_, alias_threshold_);
+
+    // Operation mix
+    double new_order = std::max(config.new_order_weight, 0.0);
+    double serve_dish = std::max(config.serve_dish_weight, 0.0);
+    double release = std::max(config.release_weight, 0.0);
+    double total = new_order + serve_dish + release;
+    if (total <= 0) {
+        new_order = total = 1;
+    }
+    double release_cuisine = release * std::min(std::max(config.release_cuisine_share, 0.0), 1.0);
+    new_order_cutoff_ = cutoff(new_order / total);
+    serve_dish_cutoff_ = cutoff((new_order + serve_dish) / total);
+    release_cuisine_cutoff_ = cutoff((new_order + serve_dish + release_cuisine) / total);
+    release_prep_threshold_ = std::max(1, static_cast<int>(std::lround(config.quick_prep_mean)));
+}
+
+/**
+ * @return The menu the operations refer to.
+ */
+const std::vector<Dish>& WorkloadGenerator::menu() const {
+    return menu_;
+}
+
+/**
+ * @post Writes the next `count` operations of the stream to `out`.
+ */
+void WorkloadGenerator::generate(Operation* out, size_t count) {
+    TRACE_SCOPE_N("WorkloadGenerator::generate", static_cast<int64_t>(count));
+    for (size_t i = 0; i < count; i++) {
+        out[i] = next();
+    }
+}
+
+/**
+ * @return The next `count` operations of the stream.
+ */
+std::vector<Operation> WorkloadGenerator::batch(size_t count) {
+    std::vector<Operation> ops(count);
+    generate(ops.data(), count);
+    return ops;
+}
+
+/**
+ * @return True if the next `count` operations were written to the file, false otherwise.
+ */
+bool WorkloadGenerator::writeFile(const std::string& path, size_t count) {
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    uint64_t stored_count = count;
+    file.write(FILE_MAGIC, sizeof(FILE_MAGIC));
+    file.write(reinterpret_cast<const char*>(&stored_count), sizeof(stored_count));
+
+    // Generate and write in chunks so large streams never need to be held in memory
+    const size_t CHUNK = 1 << 16;
+    std::vector<Operation> chunk(CHUNK);
+    for (size_t written = 0; written < count; written += CHUNK) {
+        size_t n = std::min(CHUNK, count - written);
+        generate(chunk.data(), n);
+        file.write(reinterpret_cast<const char*>(chunk.data()), n * sizeof(Operation));
+    }
+    return static_cast<bool>(file);
+}
+
+/**
+ * @return True if the file was read successfully, false otherwise.
+ */
+bool WorkloadGenerator::readFile(const std::string& path, std::vector<Operation>& ops) {
+    TRACE_SCOPE("WorkloadGenerator::readFile");
+    std::ifstream file(path, std::ios::binary);
+    char magic[sizeof(FILE_MAGIC)];
+    uint64_t count = 0;
+    if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, FILE_MAGIC, sizeof(magic)) != 0 ||
+        !file.read(reinterpret_cast<char*>(&count), sizeof(count))) {
+        return false;
+    }
+
+    // A truncated or corrupt header must not size the allocation: the file has to hold every op
+    std::streampos header_end = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff remaining = file.tellg() - header_end;
+    if (remaining < 0 || count > static_cast<uint64_t>(remaining) / sizeof(Operation)) {
+        return false;
+    }
+    file.seekg(header_end);
+
+    ops.resize(count);
+    if (!file.read(reinterpret_cast<char*>(ops.data()), count * sizeof(Operation))) {
+        return false;
+    }
+    for (const Operation& op : ops) {
+        bool valid = op.type <= Operation::RELEASE_CUISINE && op.arg >= 0 &&
+                     (op.type != Operation::RELEASE_CUISINE || op.arg <= Dish::CuisineType::OTHER);
+        if (!valid) {
+            ops.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @return The result of the Kitchen call: 1/0 for newOrder and serveDish, the number of removed
+ * dishes for the release operations.
+ */
+int WorkloadGenerator::apply(Kitchen& kitchen, const Operation& op) const {
+    bool menu_op = op.type == Operation::NEW_ORDER || op.type == Operation::SERVE_DISH;
+    if (menu_op && (op.arg < 0 || static_cast<size_t>(op.arg) >= menu_.size())) {
+        return 0; // e.g. a stream recorded with a larger menu
+    }
+    switch (op.type) {
+        case Operation::NEW_ORDER: return kitchen.newOrder(menu_[op.arg]);
+        case Operation::SERVE_DISH: return kitchen.serveDish(menu_[op.arg]);
+        case Operation::RELEASE_BELOW_PREP_TIME: return kitchen.releaseDishesBelowPrepTime(op.arg);
+        case Operation::RELEASE_CUISINE:
+            return kitchen.releaseDishesOfCuisineType(Dish::cuisineName(static_cast<Dish::CuisineType>(op.arg)));
+    }
+    return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file Workload.hpp
+ * @brief This file contains the declaration of the WorkloadGenerator class, a deterministic, seedable
+ * generator of synthetic menus and Kitchen operation streams.
+ *
+ * The generator first builds a menu of distinct dishes whose cuisines follow configurable weights,
+ * whose ingredient counts are uniform in a configurable range and whose prep times are bimodal
+ * (a "quick" and a "slow" normal distribution). It then emits operations against that menu: dishes
+ * are ordered with Zipf-distributed popularity, served from the recently ordered dishes, and released
+ * in bulk, in tunable proportions. Operations refer to dishes by menu index, so a stream is cheap to
+ * produce, store and replay.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#ifndef WORKLOAD_HPP
+#define WORKLOAD_HPP
+
+#include "Dish.hpp"
+#include "Kitchen.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Configuration of a synthetic workload. Every field has a usable default.
+ */
+struct WorkloadConfig {
+    uint64_t seed = 42;
+    int menu_size = 500;              // Number of distinct dishes on the menu
+    double zipf_exponent = 1.0;       // Popularity skew; 0 is uniform
+
+    // Relative weights of ITALIAN, MEXICAN, CHINESE, INDIAN, AMERICAN, FRENCH, OTHER
+    std::vector<double> cuisine_weights = {1, 1, 1, 1, 1, 1, 1};
+    int min_ingredients = 1;
+    int max_ingredients = 8;
+
+    // Bimodal prep time in minutes: a quick mode and a slow mode
+    double quick_prep_mean = 15;
+    double quick_prep_stddev = 5;
+    double slow_prep_mean = 75;
+    double slow_prep_stddev = 20;
+    double slow_fraction = 0.3;       // Share of the menu drawn from the slow mode
+
+    double min_price = 4.0;
+    double max_price = 40.0;
+
+    // Relative weights of the operation types
+    double new_order_weight = 0.5;
+    double serve_dish_weight = 0.45;
+    double release_weight = 0.05;
+    double release_cuisine_share = 0.5; // Share of releases that are by cuisine rather than prep time
+};
+
+/**
+ * One generated Kitchen operation. `arg` is a menu index for NEW_ORDER and SERVE_DISH, a prep time
+ * threshold for RELEASE_BELOW_PREP_TIME and a Dish::CuisineType for RELEASE_CUISINE.
+ */
+struct Operation {
+    enum Type : uint8_t { NEW_ORDER, SERVE_DISH, RELEASE_BELOW_PREP_TIME, RELEASE_CUISINE };
+    Type type;
+    int32_t arg;
+};
+
+class WorkloadGenerator {
+public:
+    /**
+     * @param config The workload configuration.
+     * @post Builds the menu and the samplers. The same config always yields the same menu and stream.
+     */
+    explicit WorkloadGenerator(const WorkloadConfig& config = WorkloadConfig());
+
+    /**
+     * @return The menu the operations refer to.
+     */
+    const std::vector<Dish>& menu() const;
+
+    /**
+     * @return The next operation of the stream.
+     */
+    inline Operation next();
+
+    /**
+     * @param out Destination of the operations.
+     * @param count The number of operations to generate.
+     * @post Writes the next `count` operations of the stream to `out`.
+     */
+    void generate(Operation* out, size_t count);
+
+    /**
+     * @param count The number of operations to generate.
+     * @return The next `count` operations of the stream.
+     */
+    std::vector<Operation> batch(size_t count);
+
+    /**
+     * @param path The file to write.
+     * @param count The number of operations to generate.
+     * @return True if the next `count` operations were written to the file, false otherwise.
+     */
+    bool writeFile(const std::string& path, size_t count);
+
+    /**
+     * @param path A file written by writeFile.
+     * @param ops Receives the operations stored in the file.
+     * @return True if the file was read successfully; false if it could not be read, is shorter
+     * than its header says, or holds an operation of unknown type or out-of-range argument.
+     */
+    static bool readFile(const std::string& path, std::vector<Operation>& ops);
+
+    /**
+     * @param kitchen The kitchen the operation is applied to.
+     * @param op An operation generated against this generator's menu.
+     * @return The result of the Kitchen call: 1/0 for newOrder and serveDish, the number of removed
+     * dishes for the release operations. A newOrder or serveDish whose menu index is outside this
+     * generator's menu (a stream recorded with another config) does nothing and returns 0.
+     */
+    int apply(Kitchen& kitchen, const Operation& op) const;
+
+private:
+    static const int RECENT_SIZE = 64; // Recently ordered dishes that SERVE_DISH picks from
+
+    // splitmix64: tiny, fast and statistically sound for workload generation
+    uint64_t state_;
+    inline uint64_t nextRandom();
+    inline uint32_t nextBelow(uint32_t bound);
+
+    // Vose alias table over the menu for O(1) Zipf sampling
+    std::vector<uint32_t> alias_;
+    std::vector<uint64_t> alias_threshold_;
+    inline int sampleDish();
+
+    std::vector<Dish> menu_;
+    std::vector<uint32_t> cuisine_alias_;
+    std::vector<uint64_t> cuisine_threshold_;
+    uint64_t new_order_cutoff_;
+    uint64_t serve_dish_cutoff_;
+    uint64_t release_cuisine_cutoff_;
+    int release_prep_threshold_;
+    int recent_[RECENT_SIZE];
+    unsigned recent_count_;
+};
+
+// ********* INLINE FUNCTIONS **************//
+
+inline uint64_t WorkloadGenerator::nextRandom() {
+    uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+inline uint32_t WorkloadGenerator::nextBelow(uint32_t bound) {
+    return static_cast<uint32_t>(((nextRandom() >> 32) * bound) >> 32);
+}
+
+inline int WorkloadGenerator::sampleDish() {
+    uint64_t random = nextRandom();
+    uint32_t column = static_cast<uint32_t>(((random >> 32) * alias_.size()) >> 32);
+    return (random & 0xFFFFFFFFULL) < alias_threshold_[column] ? column : alias_[column];
+}
+
+/**
+ * @return The next operation of the stream.
+ */
+inline Operation WorkloadGenerator::next() {
+    uint64_t pick = nextRandom();
+    if (pick < new_order_cutoff_) {
+        int dish = sampleDish();
+        recent_[recent_count_++ % RECENT_SIZE] = dish;
+        return {Operation::NEW_ORDER, dish};
+    }
+    if (pick < serve_dish_cutoff_) {
+        unsigned available = recent_count_ < RECENT_SIZE ? recent_count_ : RECENT_SIZE;
+        int dish = available == 0 ? sampleDish() : recent_[nextBelow(available)];
+        return {Operation::SERVE_DISH, dish};
+    }
+    if (pick < release_cuisine_cutoff_) {
+        uint64_t random = nextRandom();
+        uint32_t column = static_cast<uint32_t>(((random >> 32) * cuisine_alias_.size()) >> 32);
+        int cuisine = (random & 0xFFFFFFFFULL) < cuisine_threshold_[column] ? column : cuisine_alias_[column];
+        return {Operation::RELEASE_CUISINE, cuisine};
+    }
+    return {Operation::RELEASE_BELOW_PREP_TIME, release_prep_threshold_};
+}
+
+#endif // WORKLOAD_HPP
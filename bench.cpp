@@ -0,0 +1,602 @@
+/**
+ * @file bench.cpp
+ * @brief Micro-benchmark suite for ArrayBag, Dish and Kitchen.
+ *
+ * Every ArrayBag and Kitchen benchmark, including the 50/50 order churn, is swept over the sizes 10,
+ * 100, ..., 1000000, skipping the sizes that exceed the capacity of the bag. Results are printed as a
+ * table and, with --json, written as a JSON document that includes the raw samples.
+ *
+ * Usage: ./benchmark [--json FILE] [--filter TEXT] [--reps N] [--warmup N] [--min-time MS]
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "AllocTracker.hpp"
+#include "ArrayBag.hpp"
+#include "Benchmark.hpp"
+#include "Dish.hpp"
+#include "Instrumentation.hpp"
+#include "Kitchen.hpp"
+#include "KitchenFleet.hpp"
+#include "KitchenLatency.hpp"
+#include "PerfCounters.hpp"
+#include "ThreadPool.hpp"
+#include "Trace.hpp"
+#include "Workload.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Discards everything written to it, so kitchenReport can be timed without a terminal
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+// Reports OpCounters per operation; only registered when built with KITCHEN_INSTRUMENT
+class OpCounterProbe : public BenchmarkProbe {
+public:
+    void start() override { start_ = OpCounters::snapshot(); }
+
+    void stop() override { accumulate(OpCounters::snapshot() - start_); }
+
+    void report(std::vector<std::pair<std::string, double>>& counters, long long ops) override {
+        counters.push_back({"dish_compares_per_op", static_cast<double>(total_.dish_compares) / ops});
+        counters.push_back({"dish_copies_per_op", static_cast<double>(total_.dish_copies) / ops});
+        counters.push_back({"dish_moves_per_op", static_cast<double>(total_.dish_moves) / ops});
+        counters.push_back({"slots_scanned_per_op", static_cast<double>(total_.slots_scanned) / ops});
+        counters.push_back({"elements_shifted_per_op", static_cast<double>(total_.elements_shifted) / ops});
+        for (int i = 0; i < OpCounterSnapshot::KITCHEN_METHOD_COUNT; i++) {
+            if (total_.kitchen_calls[i] != 0) {
+                counters.push_back({std::string("calls_") + OpCounterSnapshot::methodName(i) + "_per_op",
+                                    static_cast<double>(total_.kitchen_calls[i]) / ops});
+            }
+        }
+        total_ = OpCounterSnapshot();
+    }
+
+private:
+    OpCounterSnapshot start_;
+    OpCounterSnapshot total_;
+
+    void accumulate(const OpCounterSnapshot& delta) {
+        total_.dish_compares += delta.dish_compares;
+        total_.dish_copies += delta.dish_copies;
+        total_.dish_moves += delta.dish_moves;
+        total_.slots_scanned += delta.slots_scanned;
+        total_.elements_shifted += delta.elements_shifted;
+        for (int i = 0; i < OpCounterSnapshot::KITCHEN_METHOD_COUNT; i++) {
+            total_.kitchen_calls[i] += delta.kitchen_calls[i];
+        }
+    }
+};
+
+// Reports heap allocations per operation (AllocTracker replaces the global operator new)
+class AllocProbe : public BenchmarkProbe {
+public:
+    void start() override { start_ = AllocTracker::threadStats(); }
+
+    void stop() override {
+        AllocStats delta = AllocTracker::threadStats() - start_;
+        total_.allocations += delta.allocations;
+        total_.bytes += delta.bytes;
+        total_.frees += delta.frees;
+    }
+
+    void report(std::vector<std::pair<std::string, double>>& counters, long long ops) override {
+        counters.push_back({"allocs_per_op", static_cast<double>(total_.allocations) / ops});
+        counters.push_back({"alloc_bytes_per_op", static_cast<double>(total_.bytes) / ops});
+        counters.push_back({"frees_per_op", static_cast<double>(total_.frees) / ops});
+        total_ = AllocStats();
+    }
+
+private:
+    AllocStats start_;
+    AllocStats total_;
+};
+
+// Reports hardware counters per operation; events that could not be opened are left out
+class PerfProbe : public BenchmarkProbe {
+public:
+    explicit PerfProbe(PerfCounters& counters) : counters_(counters) { counters_.reset(); }
+
+    void start() override { counters_.start(); }
+
+    void stop() override { counters_.stop(); }
+
+    void report(std::vector<std::pair<std::string, double>>& counters, long long ops) override {
+        PerfCounters::Reading reading = counters_.read();
+        for (int i = 0; i < PerfCounters::EVENT_COUNT; i++) {
+            if (reading.valid[i]) {
+                counters.push_back({std::string(PerfCounters::eventName(i)) + "_per_op",
+                                    static_cast<double>(reading.values[i]) / ops});
+            }
+        }
+        if (reading.valid[PerfCounters::CYCLES] && reading.valid[PerfCounters::INSTRUCTIONS] &&
+            reading.values[PerfCounters::CYCLES] != 0) {
+            counters.push_back({"ipc", static_cast<double>(reading.values[PerfCounters::INSTRUCTIONS]) /
+                                           reading.values[PerfCounters::CYCLES]});
+        }
+        counters_.reset();
+    }
+
+private:
+    PerfCounters& counters_;
+};
+
+// Builds a valid (letters and spaces only) and unique dish name from an index
+static std::string dishName(int index) {
+    std::string name = "Dish ";
+    do {
+        name += static_cast<char>('A' + index % 26);
+        index /= 26;
+    } while (index > 0);
+    return name;
+}
+
+// Builds `count` distinct dishes covering every cuisine type and a spread of prep times
+static std::vector<Dish> makeDishes(int count) {
+    static const std::vector<std::string> short_list = {"Pasta", "Tomato Sauce", "Basil"};
+    static const std::vector<std::string> long_list = {"Beef", "Potatoes", "Carrots", "Onions", "Garlic"};
+    std::vector<Dish> dishes;
+    dishes.reserve(count);
+    for (int i = 0; i < count; i++) {
+        dishes.push_back(Dish(dishName(i), (i % 3 == 0) ? long_list : short_list, 10 + (i * 7) % 110,
+                              5.0 + (i % 40) * 0.75, static_cast<Dish::CuisineType>(i % 7)));
+    }
+    return dishes;
+}
+
+// Returns the number of dishes an ArrayBag can hold, found by filling one until add fails
+static int bagCapacity() {
+    ArrayBag<Dish> bag;
+    int capacity = 0;
+    for (const Dish& dish : makeDishes(1000)) {
+        if (!bag.add(dish)) {
+            break;
+        }
+        capacity++;
+    }
+    return capacity;
+}
+
+template <class Bag>
+static void fill(Bag& bag, const std::vector<Dish>& dishes) {
+    for (const Dish& dish : dishes) {
+        bag.add(dish);
+    }
+}
+
+static void fillKitchen(Kitchen& kitchen, const std::vector<Dish>& dishes) {
+    for (const Dish& dish : dishes) {
+        kitchen.newOrder(dish);
+    }
+}
+
+static void benchArrayBag(BenchmarkRunner& runner, int n) {
+    std::vector<Dish> dishes = makeDishes(n);
+    Dish missing("Not On The Menu", {}, 1, 1.0);
+    ArrayBag<Dish> bag;
+
+    runner.run("ArrayBag::add", n, n, [&] { bag.clear(); }, [&] {
+        for (const Dish& dish : dishes) {
+            doNotOptimize(bag.add(dish));
+        }
+    });
+
+    runner.run("ArrayBag::remove", n, n, [&] { bag.clear(); fill(bag, dishes); }, [&] {
+        for (const Dish& dish : dishes) {
+            doNotOptimize(bag.remove(dish));
+        }
+    });
+
+    bag.clear();
+    fill(bag, dishes);
+    runner.run("ArrayBag::contains/hit", n, n, nullptr, [&] {
+        for (const Dish& dish : dishes) {
+            doNotOptimize(bag.contains(dish));
+        }
+    });
+    runner.run("ArrayBag::contains/miss", n, 1, nullptr, [&] { doNotOptimize(bag.contains(missing)); });
+    runner.run("ArrayBag::getFrequencyOf", n, n, nullptr, [&] {
+        for (const Dish& dish : dishes) {
+            doNotOptimize(bag.getFrequencyOf(dish));
+        }
+    });
+}
+
+static void benchDish(BenchmarkRunner& runner) {
+    const std::string name = "Beef Stew";
+    const std::vector<std::string> ingredients = {"Beef", "Potatoes", "Carrots", "Onions", "Garlic"};
+    Dish original(name, ingredients, 90, 20.99, Dish::CuisineType::AMERICAN);
+    Dish same(name, ingredients, 90, 20.99, Dish::CuisineType::AMERICAN);
+    Dish other(name, ingredients, 90, 21.99, Dish::CuisineType::AMERICAN);
+
+    runner.run("Dish::Dish", 1, 1, nullptr, [&] {
+        Dish dish(name, ingredients, 90, 20.99, Dish::CuisineType::AMERICAN);
+        doNotOptimize(dish);
+    });
+    runner.run("Dish::Dish(const Dish&)", 1, 1, nullptr, [&] {
+        Dish copy(original);
+        doNotOptimize(copy);
+    });
+    runner.run("Dish::getIngredients", 1, 1, nullptr, [&] {
+        std::vector<std::string> list = original.getIngredients();
+        doNotOptimize(list);
+    });
+    runner.run("Dish::getIngredientRange", 1, 1, nullptr, [&] {
+        size_t length = 0;
+        for (std::string_view ingredient : original.getIngredientRange()) {
+            length += ingredient.size();
+        }
+        doNotOptimize(length);
+    });
+    runner.run("Dish::operator==/equal", 1, 1, nullptr, [&] { doNotOptimize(original == same); });
+    runner.run("Dish::operator==/unequal", 1, 1, nullptr, [&] { doNotOptimize(original == other); });
+
+    NullBuffer null_buffer;
+    std::ostream null_stream(&null_buffer);
+    runner.run("Dish::display", 1, 1, nullptr, [&] { original.display(null_stream); });
+    runner.run("Dish::renderTo", 1, 1, nullptr, [&] {
+        char buffer[256];
+        doNotOptimize(original.renderTo(buffer, sizeof(buffer)));
+        doNotOptimize(buffer);
+    });
+
+    const std::string long_name = "Slow Roasted Pork Shoulder with Apple and Fennel Slaw";
+    runner.run("Dish::isValidName", 1, 1, nullptr, [&] { doNotOptimize(Dish::isValidName(name)); });
+    runner.run("Dish::isValidName/long", 1, 1, nullptr, [&] { doNotOptimize(Dish::isValidName(long_name)); });
+    const std::vector<std::string> names(1000, long_name);
+    std::vector<bool> valid;
+    runner.run("Dish::validateNames", 1000, 1000, nullptr, [&] { doNotOptimize(Dish::validateNames(names, valid)); });
+}
+
+static void benchLatencyTimer(BenchmarkRunner& runner) {
+    // Cost of the sampled timing added to every timed Kitchen operation
+    runner.run("KitchenLatency::Timer", 1, 1, nullptr, [] { KitchenLatency::Timer timer(KitchenLatency::NEW_ORDER); });
+
+    // Cost of a timer while the timers are off
+    KitchenLatency::setEnabled(false);
+    runner.run("KitchenLatency::Timer/disabled", 1, 1, nullptr,
+               [] { KitchenLatency::Timer timer(KitchenLatency::NEW_ORDER); });
+    KitchenLatency::setEnabled(true);
+
+    // Cost of a trace span while tracing is disabled
+    runner.run("TraceSpan/disabled", 1, 1, nullptr, [] { TRACE_SCOPE("disabled span"); });
+}
+
+static void benchKitchen(BenchmarkRunner& runner, int n) {
+    std::vector<Dish> dishes = makeDishes(n);
+    Kitchen kitchen;
+
+    runner.run("Kitchen::newOrder", n, n, [&] { kitchen = Kitchen(); }, [&] {
+        for (const Dish& dish : dishes) {
+            doNotOptimize(kitchen.newOrder(dish));
+        }
+    });
+
+    runner.run("Kitchen::serveDish", n, n, [&] { kitchen = Kitchen(); fillKitchen(kitchen, dishes); }, [&] {
+        for (const Dish& dish : dishes) {
+            doNotOptimize(kitchen.serveDish(dish));
+        }
+    });
+
+    kitchen = Kitchen();
+    fillKitchen(kitchen, dishes);
+    runner.run("Kitchen::newOrder/duplicate", n, n, nullptr, [&] {
+        for (const Dish& dish : dishes) {
+            doNotOptimize(kitchen.newOrder(dish));
+        }
+    });
+    runner.run("Kitchen::getPrepTimeSum", n, 1, nullptr, [&] { doNotOptimize(kitchen.getPrepTimeSum()); });
+    runner.run("Kitchen::calculateAvgPrepTime", n, 1, nullptr, [&] {
+        doNotOptimize(kitchen.calculateAvgPrepTime());
+    });
+    runner.run("Kitchen::elaborateDishCount", n, 1, nullptr, [&] {
+        doNotOptimize(kitchen.elaborateDishCount());
+    });
+    runner.run("Kitchen::calculateElaboratePercentage", n, 1, nullptr, [&] {
+        doNotOptimize(kitchen.calculateElaboratePercentage());
+    });
+    runner.run("Kitchen::tallyCuisineTypes", n, 1, nullptr, [&] {
+        doNotOptimize(kitchen.tallyCuisineTypes("MEXICAN"));
+    });
+
+    runner.run("Kitchen/copy and std::sort by prep time", n, 1, nullptr, [&] {
+        std::vector<Dish> copies(dishes.begin(), dishes.begin() + n);
+        std::sort(copies.begin(), copies.end(),
+                  [](const Dish& left, const Dish& right) { return left.getPrepTime() < right.getPrepTime(); });
+        doNotOptimize(copies);
+    });
+    runner.run("Kitchen::sortedView/prep time", n, 1, nullptr,
+               [&] { doNotOptimize(kitchen.sortedView(Kitchen::PREP_TIME)); });
+    runner.run("Kitchen::sortedView/price", n, 1, nullptr,
+               [&] { doNotOptimize(kitchen.sortedView(Kitchen::PRICE_CENTS)); });
+
+    NullBuffer null_buffer;
+    std::streambuf* saved = std::cout.rdbuf(&null_buffer);
+    runner.run("Kitchen::kitchenReport", n, 1, nullptr, [&] { kitchen.kitchenReport(); });
+    runner.run("Kitchen::report/unchanged", n, 1, nullptr, [&] { doNotOptimize(kitchen.report().version); });
+    bool served = false;
+    runner.run("Kitchen::report/after a change", n, 1,
+               [&] { served = served ? !kitchen.newOrder(dishes[0]) : kitchen.serveDish(dishes[0]); },
+               [&] { doNotOptimize(kitchen.report().version); });
+    if (served) {
+        kitchen.newOrder(dishes[0]);
+    }
+    runner.run("Dish::display/every dish", n, n, nullptr, [&] {
+        for (int i = 0; i < n; i++) {
+            dishes[i].display();
+        }
+    });
+    runner.run("Kitchen::renderAll", n, n, nullptr, [&] { doNotOptimize(kitchen.renderAll(std::cout)); });
+    std::cout.rdbuf(saved);
+
+    runner.run("Kitchen::releaseDishesBelowPrepTime", n, 1, [&] { kitchen = Kitchen(); fillKitchen(kitchen, dishes); },
+               [&] { doNotOptimize(kitchen.releaseDishesBelowPrepTime(60)); });
+    runner.run("Kitchen::releaseDishesOfCuisineType", n, 1, [&] { kitchen = Kitchen(); fillKitchen(kitchen, dishes); },
+               [&] { doNotOptimize(kitchen.releaseDishesOfCuisineType("ITALIAN")); });
+    runner.run("Kitchen::releaseWhere", n, 1, [&] { kitchen = Kitchen(); fillKitchen(kitchen, dishes); }, [&] {
+        doNotOptimize(kitchen.releaseWhere([](const Dish& dish) {
+            return dish.getCuisineTypeEnum() == Dish::CuisineType::MEXICAN && dish.getPrice() > 15;
+        }));
+    });
+
+    // The cost of recording, and of undoing and redoing a whole-kitchen release
+    runner.run("Kitchen::newOrder/undo on", n, n, [&] { kitchen = Kitchen(); kitchen.enableUndo(); }, [&] {
+        for (const Dish& dish : dishes) {
+            doNotOptimize(kitchen.newOrder(dish));
+        }
+    });
+    auto releaseAll = [&] {
+        kitchen = Kitchen();
+        fillKitchen(kitchen, dishes);
+        kitchen.enableUndo();
+        kitchen.releaseDishesOfCuisineType("ALL");
+    };
+    runner.run("Kitchen::undo/release ALL", n, 1, releaseAll, [&] { doNotOptimize(kitchen.undo()); });
+    runner.run("Kitchen::redo/release ALL", n, 1, [&] { releaseAll(); kitchen.undo(); },
+               [&] { doNotOptimize(kitchen.redo()); });
+    kitchen.disableUndo();
+}
+
+// 50/50 newOrder/serveDish churn: the kitchen holds n/2 dishes while orders rotate through n.
+// Every newOrder lands in the slot the previous serveDish retired, so after the first rotation
+// the dishes are recycled in place (allocs_per_op shows whether any capacity had to grow).
+static void benchChurn(BenchmarkRunner& runner, int n, const char* name, const std::vector<Dish>& dishes) {
+    Kitchen kitchen;
+    int half = n / 2;
+    for (int i = 0; i < half; i++) {
+        kitchen.newOrder(dishes[i]);
+    }
+    int position = 0;
+    runner.run(name, n, 2LL * n, nullptr, [&] {
+        for (int i = 0; i < n; i++) {
+            doNotOptimize(kitchen.serveDish(dishes[position]));
+            doNotOptimize(kitchen.newOrder(dishes[(position + half) % n]));
+            position = (position + 1) % n;
+        }
+    });
+}
+
+static void benchChurn(BenchmarkRunner& runner, int n) {
+    benchChurn(runner, n, "Kitchen/churn 50-50", makeDishes(n));
+
+    // Same churn with strings too long for the small-string buffer, and ingredient lists that
+    // change length from one dish to the next
+    std::vector<Dish> long_dishes;
+    for (int i = 0; i < n; i++) {
+        std::vector<std::string> ingredients;
+        for (int j = 0; j <= i % 6; j++) {
+            ingredients.push_back("Slow Roasted Ingredient " + dishName(j));
+        }
+        long_dishes.push_back(Dish("Chef Special With Long Name " + dishName(i), ingredients, 10 + i % 90, 9.5,
+                                   static_cast<Dish::CuisineType>(i % 7)));
+    }
+    benchChurn(runner, n, "Kitchen/churn 50-50 long strings", long_dishes);
+}
+
+// Loading an order set of 10 copies each of n distinct dishes into an empty kitchen
+static void benchBulkLoad(BenchmarkRunner& runner, int n) {
+    std::vector<Dish> dishes = makeDishes(n);
+    std::vector<Dish> order_set;
+    for (int copy = 0; copy < 10; copy++) {
+        order_set.insert(order_set.end(), dishes.begin(), dishes.end());
+    }
+    Kitchen kitchen;
+    runner.run("Kitchen/newOrder each of order set", n, order_set.size(), [&] { kitchen = Kitchen(); }, [&] {
+        for (const Dish& dish : order_set) {
+            doNotOptimize(kitchen.newOrder(dish));
+        }
+    });
+    runner.run("Kitchen::bulkLoad", n, order_set.size(), [&] { kitchen = Kitchen(); },
+               [&] { doNotOptimize(kitchen.bulkLoad(order_set)); });
+}
+
+static void benchWorkload(BenchmarkRunner& runner) {
+    WorkloadGenerator generator;
+    const long long BATCH = 4096;
+    std::vector<Operation> ops(BATCH);
+    runner.run("WorkloadGenerator::generate", generator.menu().size(), BATCH, nullptr,
+               [&] { generator.generate(ops.data(), BATCH); doNotOptimize(ops[BATCH - 1]); });
+
+    // Replay a realistic operation mix against one long-lived kitchen
+    ops = generator.batch(1 << 16);
+    Kitchen kitchen;
+    size_t position = 0;
+    runner.run("Kitchen/workload mix", generator.menu().size(), BATCH, nullptr, [&] {
+        for (long long i = 0; i < BATCH; i++) {
+            doNotOptimize(generator.apply(kitchen, ops[position]));
+            position = (position + 1) % ops.size();
+        }
+    });
+
+    // The orders and services of the same stream, one call each and in batches of BATCH
+    std::vector<KitchenCommand> commands;
+    for (const Operation& op : ops) {
+        if (op.type == Operation::NEW_ORDER || op.type == Operation::SERVE_DISH) {
+            commands.push_back({op.type == Operation::NEW_ORDER ? KitchenCommand::NEW_ORDER : KitchenCommand::SERVE_DISH,
+                                &generator.menu()[op.arg]});
+        }
+    }
+    commands.resize(commands.size() / BATCH * BATCH);
+    position = 0;
+    runner.run("Kitchen/commands one at a time", generator.menu().size(), BATCH, nullptr, [&] {
+        for (long long i = 0; i < BATCH; i++) {
+            const KitchenCommand& command = commands[position + i];
+            doNotOptimize(command.type == KitchenCommand::NEW_ORDER ? kitchen.newOrder(*command.dish)
+                                                                    : kitchen.serveDish(*command.dish));
+        }
+        position = (position + BATCH) % commands.size();
+    });
+    // The same with change events published; the queue is drained between samples, so none are dropped
+    KitchenEventQueue event_queue(BATCH);
+    std::vector<KitchenEvent> drained(BATCH);
+    kitchen.setEventQueue(&event_queue);
+    position = 0;
+    runner.run("Kitchen/commands one at a time/events", generator.menu().size(), BATCH,
+               [&] { event_queue.popBatch(drained.data(), drained.size()); }, [&] {
+        for (long long i = 0; i < BATCH; i++) {
+            const KitchenCommand& command = commands[position + i];
+            doNotOptimize(command.type == KitchenCommand::NEW_ORDER ? kitchen.newOrder(*command.dish)
+                                                                    : kitchen.serveDish(*command.dish));
+        }
+        position = (position + BATCH) % commands.size();
+    });
+    kitchen.setEventQueue(nullptr);
+    std::vector<KitchenCommand> batch(BATCH);
+    std::vector<bool> results;
+    position = 0;
+    runner.run("Kitchen::applyBatch", generator.menu().size(), BATCH,
+               [&] {
+                   batch.assign(commands.begin() + position, commands.begin() + position + BATCH);
+                   position = (position + BATCH) % commands.size();
+               },
+               [&] { doNotOptimize(kitchen.applyBatch(batch, results)); });
+
+    // Attribute the allocations of one pass over the stream to the Kitchen operations. A
+    // TRACK_ALLOCS build has the Kitchen open these scopes itself.
+    AllocTracker::resetScopes();
+#ifdef KITCHEN_TRACK_ALLOCS
+    for (const Operation& op : ops) {
+        generator.apply(kitchen, op);
+    }
+#else
+    static const char* const SCOPE_NAMES[] = {"Kitchen::newOrder", "Kitchen::serveDish",
+                                              "Kitchen::releaseDishesBelowPrepTime",
+                                              "Kitchen::releaseDishesOfCuisineType"};
+    for (const Operation& op : ops) {
+        AllocTracker::Scope scope(SCOPE_NAMES[op.type]);
+        generator.apply(kitchen, op);
+    }
+#endif
+    std::cout << "Heap allocations over " << ops.size() << " workload operations, by Kitchen operation:\n";
+    AllocTracker::writeScopes(std::cout);
+    std::cout << '\n';
+}
+
+// Fleet-wide scans and releases on 1, 2 and 4 threads and one per hardware thread. The fleet
+// results do not depend on the thread count, so the rows differ only in time; on a machine with
+// fewer cores than threads the extra threads only add wake-up and handoff cost.
+static void benchFleet(BenchmarkRunner& runner) {
+    const size_t FLEET_SIZE = 1000;
+    std::vector<Dish> dishes = makeDishes(bagCapacity());
+    KitchenFleet fleet(FLEET_SIZE);
+    auto fillFleet = [&] {
+        for (size_t k = 0; k < FLEET_SIZE; k++) {
+            fleet[k].clear();
+            for (size_t j = 0; j < 60; j++) {
+                fleet[k].newOrder(dishes[(k + j * 7) % dishes.size()]);
+            }
+        }
+    };
+    fillFleet();
+
+    std::vector<int> thread_counts = {1, 2, 4};
+    int hardware_threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (std::find(thread_counts.begin(), thread_counts.end(), hardware_threads) == thread_counts.end()) {
+        thread_counts.push_back(hardware_threads);
+    }
+    for (int threads : thread_counts) {
+        ThreadPool pool(threads);
+        std::string suffix = "/threads " + std::to_string(threads);
+        runner.run("KitchenFleet::tally" + suffix, FLEET_SIZE, FLEET_SIZE, nullptr,
+                   [&] { doNotOptimize(fleet.tally(pool)); });
+        runner.run("KitchenFleet::findDishes" + suffix, FLEET_SIZE, FLEET_SIZE, nullptr, [&] {
+            doNotOptimize(fleet.findDishes([](const Dish& dish) { return dish.getPrepTime() >= 60; }, pool));
+        });
+        runner.run("KitchenFleet::releaseDishesBelowPrepTime" + suffix, FLEET_SIZE, FLEET_SIZE, fillFleet,
+                   [&] { doNotOptimize(fleet.releaseDishesBelowPrepTime(60, pool)); });
+        fillFleet();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkRunner::Options options;
+    std::string json_path;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--json" && has_value) {
+            json_path = argv[++i];
+        } else if (arg == "--filter" && has_value) {
+            options.filter = argv[++i];
+        } else if (arg == "--reps" && has_value) {
+            options.repetitions = std::atoi(argv[++i]);
+        } else if (arg == "--warmup" && has_value) {
+            options.warmup_samples = std::atoi(argv[++i]);
+        } else if (arg == "--min-time" && has_value) {
+            options.min_sample_ms = std::atof(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--json FILE] [--filter TEXT] [--reps N] [--warmup N] [--min-time MS]" << std::endl;
+            return 1;
+        }
+    }
+
+    BenchmarkRunner runner(options);
+    OpCounterProbe op_counter_probe;
+    if (OpCounters::enabled()) {
+        runner.addProbe(&op_counter_probe);
+    }
+    AllocProbe alloc_probe;
+    runner.addProbe(&alloc_probe);
+
+    PerfCounters perf_counters;
+    PerfProbe perf_probe(perf_counters);
+    if (perf_counters.available()) {
+        runner.addProbe(&perf_probe);
+    }
+    if (!perf_counters.unavailableReason().empty()) {
+        std::cerr << "hardware counters unavailable: " << perf_counters.unavailableReason() << std::endl;
+        runner.addContext("perf_counters_unavailable", perf_counters.unavailableReason());
+    }
+    int capacity = bagCapacity();
+
+    benchDish(runner);
+    benchLatencyTimer(runner);
+    for (int n = 10; n <= 1000000; n *= 10) {
+        if (n > capacity) {
+            std::cerr << "skipping size " << n << ": exceeds bag capacity " << capacity << std::endl;
+            continue;
+        }
+        benchArrayBag(runner, n);
+        benchKitchen(runner, n);
+        benchChurn(runner, n);
+        benchBulkLoad(runner, n);
+    }
+    benchWorkload(runner);
+    benchFleet(runner);
+
+    runner.printSummary(std::cout);
+    if (!json_path.empty()) {
+        std::ofstream json(json_path);
+        runner.writeJson(json);
+    }
+    return 0;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file benchcompare.cpp
+ * @brief Compares benchmark results against a stored baseline and exits non-zero on a regression.
+ *
+ * Usage: ./benchcompare BASELINE.json [CURRENT.json] [--threshold PERCENT] [--alpha P]
+ *                       [--filter TEXT] [--benchmark PATH]
+ *
+ * Without CURRENT.json the benchmark suite (./benchmark, or PATH) is run first and its results are
+ * written to bench_current.json. A benchmark regressed when its median grew by more than PERCENT
+ * (default 10) and the Mann-Whitney U test is significant at P (default 0.01). With --filter, only
+ * the matching benchmarks are run and compared.
+ *
+ * Exit status: 0 if nothing regressed, 1 if something did, 2 if the results could not be read.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Benchmark.hpp"
+#include "BenchmarkCompare.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+// Runs the benchmark suite with these arguments, without a shell, so no argument is ever parsed as
+// shell syntax; returns true if it exited with status 0
+static bool runBenchmark(const std::vector<std::string>& args) {
+    std::vector<char*> argv;
+    for (const std::string& arg : args) {
+        argv.push_back(const_cast<char*>(arg.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid == 0) {
+        execvp(argv[0], argv.data());
+        std::cerr << "could not run " << args[0] << std::endl;
+        _exit(127);
+    }
+    int status = 0;
+    return pid > 0 && waitpid(pid, &status, 0) == pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+// Reads a results file written by ./benchmark --json
+static bool readResults(const std::string& path, std::vector<BenchmarkResult>& results) {
+    std::ifstream file(path);
+    if (!file || !BenchmarkRunner::readJson(file, results)) {
+        std::cerr << "could not read benchmark results from " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    BenchmarkComparer::Options options;
+    std::string baseline_path, current_path, filter;
+    std::string benchmark_path = "./benchmark";
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--threshold" && has_value) {
+            options.threshold = std::atof(argv[++i]) / 100;
+        } else if (arg == "--alpha" && has_value) {
+            options.alpha = std::atof(argv[++i]);
+        } else if (arg == "--filter" && has_value) {
+            filter = argv[++i];
+        } else if (arg == "--benchmark" && has_value) {
+            benchmark_path = argv[++i];
+        } else if (arg[0] != '-' && baseline_path.empty()) {
+            baseline_path = arg;
+        } else if (arg[0] != '-' && current_path.empty()) {
+            current_path = arg;
+        } else {
+            baseline_path.clear();
+            break;
+        }
+    }
+    if (baseline_path.empty()) {
+        std::cerr << "Usage: " << argv[0] << " BASELINE.json [CURRENT.json] [--threshold PERCENT] [--alpha P]"
+                  << " [--filter TEXT] [--benchmark PATH]" << std::endl;
+        return 2;
+    }
+
+    std::vector<BenchmarkResult> baseline, current;
+    if (!readResults(baseline_path, baseline)) {
+        return 2;
+    }
+
+    if (current_path.empty()) {
+        current_path = "bench_current.json";
+        std::vector<std::string> command = {benchmark_path, "--json", current_path};
+        if (!filter.empty()) {
+            command.push_back("--filter");
+            command.push_back(filter);
+        }
+        std::cout << "running";
+        for (const std::string& arg : command) {
+            std::cout << ' ' << arg;
+        }
+        std::cout << std::endl;
+        if (!runBenchmark(command)) {
+            std::cerr << "benchmark run failed" << std::endl;
+            return 2;
+        }
+    }
+    if (!readResults(current_path, current)) {
+        return 2;
+    }
+
+    // Compare only what was run, so a filtered run does not report the rest as missing
+    if (!filter.empty()) {
+        std::vector<BenchmarkResult> selected;
+        for (const BenchmarkResult& result : baseline) {
+            if (result.name.find(filter) != std::string::npos) {
+                selected.push_back(result);
+            }
+        }
+        baseline.swap(selected);
+    }
+
+    std::cout << "\nbaseline " << baseline_path << " vs " << current_path << " (threshold "
+              << options.threshold * 100 << "%, alpha " << options.alpha << ")\n\n";
+    BenchmarkComparer comparer(options);
+    std::vector<BenchmarkComparison> comparisons = comparer.compare(baseline, current);
+    BenchmarkComparer::printReport(comparisons, std::cout);
+
+    for (const BenchmarkComparison& comparison : comparisons) {
+        if (comparison.status == BenchmarkComparison::REGRESSION) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+/**
+ * @file loadtest.cpp
+ * @brief Open-loop load test of Kitchen, reporting latency percentiles per operation type.
+ *
+ * Usage: ./loadtest [--rate OPS_PER_SEC] [--duration SECONDS] [--constant] [--seed N] [--menu N]
+ *                   [--trace FILE]
+ *
+ * With --trace, every Kitchen operation is recorded and written to FILE as Chrome trace JSON.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Kitchen.hpp"
+#include "KitchenLatency.hpp"
+#include "LoadTester.hpp"
+#include "Trace.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    LoadTestConfig config;
+    std::string trace_path;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--rate" && has_value) {
+            config.rate = std::atof(argv[++i]);
+        } else if (arg == "--duration" && has_value) {
+            config.duration = std::atof(argv[++i]);
+        } else if (arg == "--constant") {
+            config.poisson = false;
+        } else if (arg == "--seed" && has_value) {
+            config.workload.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--menu" && has_value) {
+            config.workload.menu_size = std::atoi(argv[++i]);
+        } else if (arg == "--trace" && has_value) {
+            trace_path = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--rate OPS_PER_SEC] [--duration SECONDS] [--constant] [--seed N] [--menu N]"
+                      << " [--trace FILE]" << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << (config.poisson ? "Poisson" : "constant-rate") << " arrivals at " << config.rate
+              << " ops/s for " << config.duration << " s" << std::endl;
+
+    Trace::setEnabled(!trace_path.empty());
+    Kitchen kitchen;
+    LoadTester tester(config);
+    LoadTestResult result = tester.run(kitchen);
+    LoadTester::printReport(result, std::cout);
+
+    std::cout << "\nKitchen's built-in service time histograms:\n";
+    KitchenLatency::writeText(std::cout);
+
+    if (!trace_path.empty()) {
+        Trace::setEnabled(false);
+        std::ofstream trace(trace_path);
+        Trace::writeJson(trace);
+        std::cout << "\ntrace written to " << trace_path << " (" << Trace::dropped() << " events dropped)" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file metrics.cpp
+ * @brief Runs a synthetic workload against a Kitchen and exports its metrics in the Prometheus text
+ * format, or acts as a stand-in scraper for such an export.
+ *
+ * Usage: ./metrics [--ops N] [--seed N] [--file PATH] [--socket PATH [--scrapes N]]
+ *        ./metrics --scrape SOCKET
+ *
+ * Without --file or --socket the metrics are written to standard output. With --socket, N scrapes
+ * are answered and another N operations run between consecutive scrapes.
+ *
+ * @date 10/17/2026
+ * @author Mitchell Lipyansky
+ */
+
+#include "Kitchen.hpp"
+#include "Metrics.hpp"
+#include "Workload.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+int main(int argc, char* argv[]) {
+    WorkloadConfig config;
+    long long ops = 100000;
+    int scrapes = 1;
+    std::string file_path, socket_path, scrape_path;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--ops" && has_value) {
+            ops = std::atoll(argv[++i]);
+        } else if (arg == "--seed" && has_value) {
+            config.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--file" && has_value) {
+            file_path = argv[++i];
+        } else if (arg == "--socket" && has_value) {
+            socket_path = argv[++i];
+        } else if (arg == "--scrapes" && has_value) {
+            scrapes = std::atoi(argv[++i]);
+        } else if (arg == "--scrape" && has_value) {
+            scrape_path = argv[++i];
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--ops N] [--seed N] [--file PATH] [--socket PATH [--scrapes N]]\n"
+                      << "       " << argv[0] << " --scrape SOCKET" << std::endl;
+            return 1;
+        }
+    }
+
+    // Stand-in scraper: print whatever the exporter serves
+    if (!scrape_path.empty()) {
+        std::string body;
+        if (!MetricsRegistry::scrapeUnixSocket(scrape_path, body)) {
+            std::cerr << "could not scrape " << scrape_path << std::endl;
+            return 1;
+        }
+        std::cout << body;
+        return 0;
+    }
+
+    Kitchen kitchen;
+    WorkloadGenerator generator(config);
+    auto runWorkload = [&]() {
+        for (long long i = 0; i < ops; i++) {
+            generator.apply(kitchen, generator.next());
+        }
+    };
+    runWorkload();
+
+    MetricsRegistry registry;
+    registry.addKitchen(kitchen, "main");
+
+    if (!file_path.empty()) {
+        if (!registry.writeFile(file_path)) {
+            std::cerr << "could not write " << file_path << std::endl;
+            return 1;
+        }
+        std::cout << "metrics written to " << file_path << std::endl;
+    }
+    if (!socket_path.empty()) {
+        std::cout << "serving " << scrapes << " scrape(s) on " << socket_path << std::endl;
+        if (!registry.serveUnixSocket(socket_path, scrapes, runWorkload)) {
+            std::cerr << "could not serve on " << socket_path << std::endl;
+            return 1;
+        }
+    }
+    if (file_path.empty() && socket_path.empty()) {
+        registry.render(std::cout);
+    }
+    return 0;
+}
@@ -1,5 +1,23 @@
+#include "AllocTracker.hpp"
 #include "Kitchen.hpp"
+#include "KitchenFleet.hpp"
+#include "KitchenLatency.hpp"
+#include "Trace.hpp"
+#include "Workload.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 int main() {
     // Test: kitchenReport function
@@ -23,5 +41,822 @@ int main() {
     // Call kitchenReport to output the current state of the kitchen
     kitchen.kitchenReport();
 
+    // Test: newOrder and serveDish reach an allocation-free steady state
+    std::cout << "\n---- Testing Steady-State Allocations ----" << std::endl;
+
+    // Order/serve churn only, against a menu larger than the kitchen
+    WorkloadConfig config;
+    config.release_weight = 0;
+    WorkloadGenerator generator(config);
+    std::vector<Operation> ops = generator.batch(200000);
+    Kitchen churn_kitchen;
+
+    // Warm up with the first half, then count the allocations of the second half
+    size_t half = ops.size() / 2;
+    for (size_t i = 0; i < half; i++) {
+        generator.apply(churn_kitchen, ops[i]);
+    }
+    AllocStats before = AllocTracker::threadStats();
+    for (size_t i = half; i < ops.size(); i++) {
+        generator.apply(churn_kitchen, ops[i]);
+    }
+    AllocStats steady = AllocTracker::threadStats() - before;
+
+    std::cout << "Heap allocations after warmup: " << steady.allocations << std::endl;
+    if (steady.allocations != 0) {
+        std::cout << "FAILED: newOrder/serveDish allocate in steady state" << std::endl;
+        return 1;
+    }
+
+    // Test: statistics stay correct through releases, without scanning for them
+    std::cout << "\n---- Testing Maintained Statistics ----" << std::endl;
+    WorkloadGenerator mixed_generator{WorkloadConfig()};
+    Kitchen mixed_kitchen;
+    for (int i = 0; i < 50000; i++) {
+        mixed_generator.apply(mixed_kitchen, mixed_generator.next());
+    }
+
+    // Recompute from the menu, whose dishes are all distinct
+    int expected_prep_sum = 0;
+    int expected_elaborate = 0;
+    int expected_cuisines[Dish::CuisineType::OTHER + 1] = {};
+    for (const Dish& dish : mixed_generator.menu()) {
+        if (mixed_kitchen.contains(dish)) {
+            expected_prep_sum += dish.getPrepTime();
+            expected_elaborate += dish.getIngredientCount() >= 5 && dish.getPrepTime() >= 60;
+            expected_cuisines[dish.getCuisineTypeEnum()]++;
+        }
+    }
+    bool statistics_match = mixed_kitchen.getPrepTimeSum() == expected_prep_sum &&
+                            mixed_kitchen.elaborateDishCount() == expected_elaborate;
+    for (int type = 0; type <= Dish::CuisineType::OTHER; type++) {
+        statistics_match = statistics_match &&
+                           mixed_kitchen.cuisineCount(static_cast<Dish::CuisineType>(type)) == expected_cuisines[type];
+    }
+    std::cout << "Prep time sum: " << mixed_kitchen.getPrepTimeSum() << " (expected " << expected_prep_sum << ")"
+              << std::endl;
+    if (!statistics_match) {
+        std::cout << "FAILED: maintained statistics differ from the dishes in the kitchen" << std::endl;
+        return 1;
+    }
+
+    // Test: a cuisine type outside the enumerators is counted, batched and released as OTHER
+    Dish unnamed_cuisine("Fusion Bowl", {"rice"}, 10, 9.5, static_cast<Dish::CuisineType>(Dish::CuisineType::OTHER + 1));
+    Kitchen cuisine_kitchen;
+    cuisine_kitchen.newOrder(unnamed_cuisine);
+    int counted_other = cuisine_kitchen.cuisineCount(Dish::CuisineType::OTHER);
+    std::vector<KitchenCommand> cuisine_commands = {{KitchenCommand::SERVE_DISH, &unnamed_cuisine},
+                                                    {KitchenCommand::NEW_ORDER, &unnamed_cuisine}};
+    std::vector<bool> cuisine_results;
+    cuisine_kitchen.applyBatch(cuisine_commands, cuisine_results);
+    int batched_other = cuisine_kitchen.cuisineCount(Dish::CuisineType::OTHER);
+    int released_other = cuisine_kitchen.releaseDishesOfCuisineType("OTHER");
+    if (counted_other != 1 || batched_other != 1 || released_other != 1 ||
+        cuisine_kitchen.cuisineCount(Dish::CuisineType::OTHER) != 0) {
+        std::cout << "FAILED: a dish of an out-of-range cuisine type was not counted as OTHER" << std::endl;
+        return 1;
+    }
+
+    // Test: isValidName accepts exactly what std::isalpha || std::isspace accepted, for every byte
+    // value at every position of names long enough for the table, SSE2 and AVX2 paths
+    std::cout << "\n---- Testing Dish Name Validation ----" << std::endl;
+    int mismatches = 0;
+    for (int byte = 0; byte < 256; byte++) {
+        char c = static_cast<char>(byte);
+        bool expected = std::isalpha(c) || std::isspace(c);
+        for (size_t length : {1, 15, 16, 17, 31, 32, 33, 64, 70}) {
+            for (size_t position = 0; position < length; position++) {
+                std::string name(length, 'k');
+                name[position] = c;
+                mismatches += Dish::isValidName(name) != expected;
+            }
+        }
+    }
+    std::vector<std::string> batch_names = {"Beef Stew", "Pad Thai 2", "", "Tarte\tTatin", "Caf\xC3\xA9",
+                                            "A Very Long Name For A Very Long Dish Indeed", "Coq-au-vin"};
+    std::vector<bool> batch_valid;
+    size_t batch_valid_count = Dish::validateNames(batch_names, batch_valid);
+    for (size_t i = 0; i < batch_names.size(); i++) {
+        mismatches += batch_valid[i] != Dish::isValidName(batch_names[i]);
+    }
+    std::cout << "Valid names in batch: " << batch_valid_count << " of " << batch_names.size() << std::endl;
+    if (mismatches != 0 || batch_valid_count != 4) {
+        std::cout << "FAILED: " << mismatches << " name validation mismatch(es)" << std::endl;
+        return 1;
+    }
+
+    // Test: display(std::ostream&), renderTo and renderAll produce exactly what the stream-based
+    // display printed, including the rounding of the price
+    std::cout << "\n---- Testing Dish Rendering ----" << std::endl;
+    auto referenceDisplay = [](const Dish& dish) {
+        std::ostringstream reference;
+        reference << "Dish Name: " << dish.getName() << std::endl << "Ingredients: ";
+        std::vector<std::string> dish_ingredients = dish.getIngredients();
+        for (size_t j = 0; j < dish_ingredients.size(); j++) {
+            reference << dish_ingredients[j] << (j + 1 < dish_ingredients.size() ? ", " : "");
+        }
+        reference << std::endl << "Preparation Time: " << dish.getPrepTime() << " minutes" << std::endl;
+        reference << std::fixed << std::setprecision(2) << "Price: $" << dish.getPrice() << std::endl;
+        reference << "Cuisine Type: " << dish.getCuisineType() << std::endl;
+        return reference.str();
+    };
+    Kitchen render_kitchen;
+    std::string expected_menu;
+    int render_mismatches = 0;
+    const double prices[] = {0, 2.675, 0.005, 0.015, 1.005, 19.999, 1e21, 123456.785, 0.125, -0.0, -3.14159};
+    for (size_t i = 0; i < sizeof(prices) / sizeof(prices[0]); i++) {
+        Dish dish(mixed_generator.menu()[i]);
+        dish.setPrice(prices[i]);
+        std::string expected = referenceDisplay(dish);
+        std::ostringstream displayed;
+        dish.display(displayed);
+        char short_buffer[16];
+        size_t rendered_length = dish.renderTo(short_buffer, sizeof(short_buffer));
+        render_mismatches += displayed.str() != expected || rendered_length != expected.size() ||
+                             expected.compare(0, sizeof(short_buffer), short_buffer, sizeof(short_buffer)) != 0;
+        if (render_kitchen.newOrder(dish)) {
+            expected_menu += expected + "\n";
+        }
+    }
+    // Prices up to $100 on and next to every eighth of a cent, which includes every rounding boundary
+    Dish price_dish(mixed_generator.menu()[0]);
+    for (int eighth_cents = 0; eighth_cents < 80000; eighth_cents++) {
+        double boundary = eighth_cents / 800.0;
+        for (double price : {boundary, std::nextafter(boundary, 0.0), std::nextafter(boundary, 1e9)}) {
+            price_dish.setPrice(price);
+            char buffer[512];
+            size_t length = price_dish.renderTo(buffer, sizeof(buffer));
+            render_mismatches += std::string(buffer, length) != referenceDisplay(price_dish);
+        }
+    }
+    std::ostringstream menu;
+    size_t menu_length = render_kitchen.renderAll(menu);
+    std::cout << "Rendered " << render_kitchen.getCurrentSize() << " dishes in " << menu_length << " characters"
+              << std::endl;
+    if (render_mismatches != 0 || menu.str() != expected_menu || menu_length != expected_menu.size()) {
+        std::cout << "FAILED: " << render_mismatches << " rendering mismatch(es)" << std::endl;
+        return 1;
+    }
+
+    // Test: bulkLoad makes the same decisions as newOrder on each input in turn, and leaves the same
+    // statistics, starting from a kitchen that already holds some of the inputs
+    std::cout << "\n---- Testing bulkLoad ----" << std::endl;
+    std::vector<Dish> order_set;
+    for (int i = 0; i < 400; i++) {
+        order_set.push_back(mixed_generator.menu()[(i * 7919) % 130]); // 130 distinct dishes, repeated
+    }
+    Kitchen bulk_kitchen;
+    Kitchen sequential_kitchen;
+    for (int i = 0; i < 30; i++) {
+        bulk_kitchen.newOrder(mixed_generator.menu()[i * 3]);
+        sequential_kitchen.newOrder(mixed_generator.menu()[i * 3]);
+    }
+    BulkLoadResult bulk_result = bulk_kitchen.bulkLoad(order_set);
+    BulkLoadResult sequential_result;
+    for (size_t i = 0; i < order_set.size(); i++) {
+        if (sequential_kitchen.contains(order_set[i])) {
+            sequential_result.duplicates.push_back(i);
+        } else if (sequential_kitchen.newOrder(order_set[i])) {
+            sequential_result.added++;
+        } else {
+            sequential_result.rejected_full.push_back(i);
+        }
+    }
+    bool bulk_matches = bulk_result.added == sequential_result.added &&
+                        bulk_result.duplicates == sequential_result.duplicates &&
+                        bulk_result.rejected_full == sequential_result.rejected_full &&
+                        bulk_kitchen.getCurrentSize() == sequential_kitchen.getCurrentSize() &&
+                        bulk_kitchen.getPrepTimeSum() == sequential_kitchen.getPrepTimeSum() &&
+                        bulk_kitchen.elaborateDishCount() == sequential_kitchen.elaborateDishCount();
+    for (int type = 0; type <= Dish::CuisineType::OTHER; type++) {
+        Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(type);
+        bulk_matches = bulk_matches && bulk_kitchen.cuisineCount(cuisine) == sequential_kitchen.cuisineCount(cuisine);
+    }
+    for (const Dish& dish : mixed_generator.menu()) {
+        bulk_matches = bulk_matches && bulk_kitchen.contains(dish) == sequential_kitchen.contains(dish);
+    }
+    std::cout << "Added " << bulk_result.added << ", duplicates " << bulk_result.duplicates.size() << ", did not fit "
+              << bulk_result.rejected_full.size() << std::endl;
+    if (!bulk_matches) {
+        std::cout << "FAILED: bulkLoad differs from calling newOrder on each dish" << std::endl;
+        return 1;
+    }
+
+    // Test: applyBatch returns and leaves what newOrder and serveDish called one at a time would
+    std::cout << "\n---- Testing applyBatch ----" << std::endl;
+    std::vector<KitchenCommand> commands;
+    for (const Operation& op : mixed_generator.batch(20000)) {
+        if (op.type == Operation::NEW_ORDER) {
+            commands.push_back({KitchenCommand::NEW_ORDER, &mixed_generator.menu()[op.arg]});
+        } else if (op.type == Operation::SERVE_DISH) {
+            commands.push_back({KitchenCommand::SERVE_DISH, &mixed_generator.menu()[op.arg]});
+        }
+    }
+    Kitchen batch_kitchen;
+    Kitchen single_kitchen;
+    std::vector<bool> batch_results;
+    int batch_mismatches = 0;
+    size_t batch_succeeded = 0;
+    for (size_t start = 0; start < commands.size(); start += 1000) {
+        std::vector<KitchenCommand> batch(commands.begin() + start,
+                                          commands.begin() + std::min(start + 1000, commands.size()));
+        batch_succeeded += batch_kitchen.applyBatch(batch, batch_results);
+        for (size_t i = 0; i < batch.size(); i++) {
+            bool single_result = batch[i].type == KitchenCommand::NEW_ORDER ? single_kitchen.newOrder(*batch[i].dish)
+                                                                             : single_kitchen.serveDish(*batch[i].dish);
+            batch_mismatches += batch_results[i] != single_result;
+        }
+        batch_mismatches += batch_kitchen.getPrepTimeSum() != single_kitchen.getPrepTimeSum() ||
+                            batch_kitchen.elaborateDishCount() != single_kitchen.elaborateDishCount() ||
+                            batch_kitchen.getCurrentSize() != single_kitchen.getCurrentSize();
+        for (int type = 0; type <= Dish::CuisineType::OTHER; type++) {
+            Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(type);
+            batch_mismatches += batch_kitchen.cuisineCount(cuisine) != single_kitchen.cuisineCount(cuisine);
+        }
+    }
+    std::cout << "Applied " << commands.size() << " commands, " << batch_succeeded << " succeeded" << std::endl;
+    if (batch_mismatches != 0) {
+        std::cout << "FAILED: " << batch_mismatches << " applyBatch mismatch(es)" << std::endl;
+        return 1;
+    }
+
+    // Test: releaseWhere and partitionInto remove exactly the matching dishes and leave the
+    // statistics of both kitchens equal to a recount
+    std::cout << "\n---- Testing releaseWhere and partitionInto ----" << std::endl;
+    const std::vector<Dish>& test_menu = mixed_generator.menu();
+    auto recountMatches = [&test_menu](const Kitchen& kitchen) {
+        int prep_sum = 0;
+        int elaborate = 0;
+        int cuisines[Dish::CuisineType::OTHER + 1] = {};
+        int size = 0;
+        for (const Dish& dish : test_menu) {
+            if (kitchen.contains(dish)) {
+                prep_sum += dish.getPrepTime();
+                elaborate += dish.getIngredientCount() >= 5 && dish.getPrepTime() >= 60;
+                cuisines[dish.getCuisineTypeEnum()]++;
+                size++;
+            }
+        }
+        bool matches = kitchen.getCurrentSize() == size && kitchen.getPrepTimeSum() == prep_sum &&
+                       kitchen.elaborateDishCount() == elaborate;
+        for (int type = 0; type <= Dish::CuisineType::OTHER; type++) {
+            matches = matches && kitchen.cuisineCount(static_cast<Dish::CuisineType>(type)) == cuisines[type];
+        }
+        return matches;
+    };
+    auto pricyMexican = [](const Dish& dish) {
+        return dish.getCuisineTypeEnum() == Dish::CuisineType::MEXICAN && dish.getPrice() > 15;
+    };
+    std::vector<Dish> filled(test_menu.begin(), test_menu.begin() + 100);
+    Kitchen where_kitchen;
+    where_kitchen.bulkLoad(filled);
+    int pricy_mexican_count = 0;
+    for (const Dish& dish : filled) {
+        pricy_mexican_count += pricyMexican(dish);
+    }
+    int released_where = where_kitchen.releaseWhere(pricyMexican);
+    bool partition_ok = released_where == pricy_mexican_count && recountMatches(where_kitchen);
+    for (const Dish& dish : filled) {
+        partition_ok = partition_ok && where_kitchen.contains(dish) != pricyMexican(dish);
+    }
+    std::vector<Dish> remaining;
+    for (const Dish& dish : filled) {
+        if (!pricyMexican(dish)) {
+            remaining.push_back(dish);
+        }
+    }
+
+    // Move the long dishes to an overflow kitchen that already has some of them and little room
+    Kitchen overflow_kitchen;
+    for (int i = 0; i < 90; i++) {
+        overflow_kitchen.newOrder(test_menu[100 + i]);
+    }
+    overflow_kitchen.newOrder(filled[0]);
+    overflow_kitchen.newOrder(filled[1]);
+    auto isLong = [](const Dish& dish) { return dish.getPrepTime() >= 60; };
+    int before_moving = where_kitchen.getCurrentSize();
+    int moved = where_kitchen.partitionInto(overflow_kitchen, isLong);
+    partition_ok = partition_ok && recountMatches(where_kitchen) && recountMatches(overflow_kitchen) &&
+                   where_kitchen.getCurrentSize() == before_moving - moved && overflow_kitchen.getCurrentSize() <= 100;
+    for (const Dish& dish : remaining) {
+        // A long dish stays here only if the overflow kitchen already had it or filled up
+        partition_ok = partition_ok &&
+                       (!isLong(dish) || overflow_kitchen.contains(dish) || overflow_kitchen.getCurrentSize() == 100) &&
+                       (where_kitchen.contains(dish) || overflow_kitchen.contains(dish));
+    }
+    std::cout << "Released " << released_where << " pricy MEXICAN dishes, moved " << moved << " long dishes"
+              << std::endl;
+    if (!partition_ok || where_kitchen.partitionInto(where_kitchen, isLong) != 0) {
+        std::cout << "FAILED: releaseWhere or partitionInto" << std::endl;
+        return 1;
+    }
+
+    // Test: sortedView is a stable sort of the slots by each key, through both the insertion sort
+    // (small kitchen) and the radix sort (full kitchen)
+    std::cout << "\n---- Testing sortedView ----" << std::endl;
+    Kitchen full_kitchen;
+    std::vector<Dish> sort_dishes(test_menu.begin(), test_menu.begin() + 100);
+    sort_dishes[3].setPrice(-2.5);
+    sort_dishes[4].setPrice(1e21);
+    sort_dishes[5].setPrepTime(-10);
+    full_kitchen.bulkLoad(sort_dishes);
+    Kitchen small_kitchen;
+    small_kitchen.bulkLoad(std::vector<Dish>(sort_dishes.begin(), sort_dishes.begin() + 20));
+    auto keyOf = [](const Dish& dish, Kitchen::SortKey key) {
+        switch (key) {
+            case Kitchen::PREP_TIME: return static_cast<double>(dish.getPrepTime());
+            case Kitchen::PRICE_CENTS: return std::round(dish.getPrice() * 100);
+            default: return static_cast<double>(dish.getCuisineTypeEnum());
+        }
+    };
+    bool sorted_ok = true;
+    for (const Kitchen* kitchen : {&full_kitchen, &small_kitchen}) {
+        for (Kitchen::SortKey key : {Kitchen::PREP_TIME, Kitchen::PRICE_CENTS, Kitchen::CUISINE}) {
+            Kitchen::SortedView view = kitchen->sortedView(key);
+            std::vector<bool> seen(kitchen->getCurrentSize(), false);
+            sorted_ok = sorted_ok && view.size() == static_cast<size_t>(kitchen->getCurrentSize());
+            for (size_t i = 0; i < view.size() && sorted_ok; i++) {
+                int slot = view.order()[i];
+                sorted_ok = slot >= 0 && slot < kitchen->getCurrentSize() && !seen[slot];
+                seen[slot] = true;
+                if (i > 0) {
+                    double previous = keyOf(view[i - 1], key);
+                    double current = keyOf(view[i], key);
+                    sorted_ok = sorted_ok && (previous < current || (previous == current && view.order()[i - 1] < slot));
+                }
+            }
+            size_t iterated = 0;
+            for (const Dish& dish : view) {
+                sorted_ok = sorted_ok && kitchen->contains(dish);
+                iterated++;
+            }
+            sorted_ok = sorted_ok && iterated == view.size();
+        }
+    }
+    Kitchen::SortedView by_prep_time = full_kitchen.sortedView(Kitchen::PREP_TIME);
+    std::cout << "Shortest prep time: " << by_prep_time[0].getPrepTime() << ", longest: "
+              << by_prep_time[by_prep_time.size() - 1].getPrepTime() << std::endl;
+    if (!sorted_ok) {
+        std::cout << "FAILED: sortedView is not a stable sort by its key" << std::endl;
+        return 1;
+    }
+
+    // Test: the kitchen iterates its dishes in place, and standard algorithms agree with the
+    // maintained statistics
+    std::cout << "\n---- Testing Iteration ----" << std::endl;
+    int iterated_dishes = 0;
+    int iterated_prep_sum = 0;
+    for (const Dish& dish : full_kitchen) {
+        iterated_dishes++;
+        iterated_prep_sum += dish.getPrepTime();
+    }
+    long mexican_dishes = std::count_if(full_kitchen.begin(), full_kitchen.end(), [](const Dish& dish) {
+        return dish.getCuisineTypeEnum() == Dish::CuisineType::MEXICAN;
+    });
+    bool iteration_ok = iterated_dishes == full_kitchen.getCurrentSize() &&
+                        iterated_prep_sum == full_kitchen.getPrepTimeSum() &&
+                        mexican_dishes == full_kitchen.cuisineCount(Dish::CuisineType::MEXICAN) &&
+                        full_kitchen.data() == full_kitchen.begin() &&
+                        full_kitchen.end() - full_kitchen.begin() == static_cast<long>(full_kitchen.size()) &&
+                        std::all_of(full_kitchen.begin(), full_kitchen.end(),
+                                    [&](const Dish& dish) { return full_kitchen.contains(dish); });
+    Kitchen empty_kitchen;
+    iteration_ok = iteration_ok && empty_kitchen.begin() == empty_kitchen.end();
+
+    // Ingredient iterators depend only on the dish, not on the (temporary) range they came from
+    Dish::IngredientRange::iterator first_ingredient = dish2.getIngredientRange().begin();
+    Dish::IngredientRange::iterator past_ingredients = dish2.getIngredientRange().end();
+    std::vector<std::string> ingredient_copies = dish2.getIngredients();
+    iteration_ok = iteration_ok &&
+                   std::distance(first_ingredient, past_ingredients) == static_cast<long>(ingredient_copies.size()) &&
+                   std::equal(first_ingredient, past_ingredients, ingredient_copies.begin()) &&
+                   std::find(first_ingredient, past_ingredients, "Garlic") != past_ingredients;
+    std::cout << "Iterated " << iterated_dishes << " dishes, " << mexican_dishes << " MEXICAN" << std::endl;
+    if (!iteration_ok) {
+        std::cout << "FAILED: iterating the kitchen disagrees with its statistics" << std::endl;
+        return 1;
+    }
+
+    // Test: fleet scans and releases give the same results on one thread and on several, and
+    // agree with a sequential pass over every kitchen
+    std::cout << "\n---- Testing KitchenFleet ----" << std::endl;
+    const size_t FLEET_SIZE = 75; // Not a multiple of the chunk size
+    KitchenFleet single_fleet(FLEET_SIZE), parallel_fleet(FLEET_SIZE);
+    for (size_t k = 0; k < FLEET_SIZE; k++) {
+        for (size_t j = 0; j < (k * 7) % 90; j++) {
+            const Dish& dish = mixed_generator.menu()[(k * 13 + j) % mixed_generator.menu().size()];
+            single_fleet[k].newOrder(dish);
+            parallel_fleet[k].newOrder(dish);
+        }
+    }
+    ThreadPool single_pool(1), parallel_pool(4);
+    FleetTally single_tally = single_fleet.tally(single_pool);
+    FleetTally parallel_tally = parallel_fleet.tally(parallel_pool);
+    FleetTally recount;
+    std::vector<const Dish*> expected_found;
+    auto is_long = [](const Dish& dish) { return dish.getPrepTime() >= 30; };
+    for (size_t k = 0; k < FLEET_SIZE; k++) {
+        for (const Dish& dish : parallel_fleet[k]) {
+            recount.dishes++;
+            recount.prep_time_sum += dish.getPrepTime();
+            recount.elaborate += dish.getPrepTime() >= 60 && dish.getIngredients().size() >= 5;
+            recount.cuisine_counts[dish.getCuisineTypeEnum()]++;
+            if (is_long(dish)) {
+                expected_found.push_back(&dish);
+            }
+        }
+    }
+    auto sameTally = [](const FleetTally& a, const FleetTally& b) {
+        return a.dishes == b.dishes && a.prep_time_sum == b.prep_time_sum && a.elaborate == b.elaborate &&
+               std::equal(a.cuisine_counts, a.cuisine_counts + FleetTally::CUISINE_TYPE_COUNT, b.cuisine_counts);
+    };
+    std::ostringstream single_report, parallel_report;
+    single_fleet.report(single_report, single_pool);
+    parallel_fleet.report(parallel_report, parallel_pool);
+    bool fleet_ok = sameTally(single_tally, recount) && sameTally(parallel_tally, recount) &&
+                    parallel_fleet.findDishes(is_long, parallel_pool) == expected_found &&
+                    single_report.str() == parallel_report.str();
+    std::vector<Dish> expected_kept; // The release compacts stably, so the rest keep fleet order
+    std::vector<Dish> fleet_kept;
+    for (size_t k = 0; k < FLEET_SIZE; k++) {
+        std::copy_if(parallel_fleet[k].begin(), parallel_fleet[k].end(), std::back_inserter(expected_kept),
+                     [](const Dish& dish) { return dish.getPrepTime() >= 20; });
+    }
+    long long single_released = single_fleet.releaseDishesBelowPrepTime(20, single_pool);
+    long long parallel_released = parallel_fleet.releaseDishesBelowPrepTime(20, parallel_pool);
+    for (size_t k = 0; k < FLEET_SIZE; k++) {
+        fleet_kept.insert(fleet_kept.end(), parallel_fleet[k].begin(), parallel_fleet[k].end());
+    }
+    fleet_ok = fleet_ok && single_released == parallel_released &&
+               sameTally(single_fleet.tally(single_pool), parallel_fleet.tally(parallel_pool)) &&
+               parallel_fleet.tally(parallel_pool).dishes == recount.dishes - parallel_released &&
+               fleet_kept == expected_kept;
+    std::cout << recount.dishes << " dishes in " << FLEET_SIZE << " kitchens, " << expected_found.size()
+              << " take 30 minutes or more, " << parallel_released << " released" << std::endl;
+    std::cout << parallel_report.str();
+    if (!fleet_ok) {
+        std::cout << "FAILED: the fleet's parallel results differ from a sequential pass" << std::endl;
+        return 1;
+    }
+
+    // Test: the cached report matches a freshly computed one, is rebuilt only after a change, and
+    // reportChangesSince returns exactly the lines that differ
+    std::cout << "\n---- Testing Report Cache ----" << std::endl;
+    auto referenceReport = [](const Kitchen& kitchen) {
+        std::ostringstream out;
+        for (const char* cuisine : {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH", "OTHER"}) {
+            out << cuisine << ": " << kitchen.tallyCuisineTypes(cuisine) << '\n';
+        }
+        out << "\nAVERAGE PREP TIME: " << kitchen.calculateAvgPrepTime() << '\n';
+        out << "ELABORATE: " << std::fixed << std::setprecision(2) << kitchen.calculateElaboratePercentage() << "%\n";
+        return out.str();
+    };
+    Kitchen report_kitchen;
+    bool report_ok = report_kitchen.report().text == referenceReport(report_kitchen) &&
+                     report_kitchen.reportChangesSince(0).size() == KitchenReport::LINE_COUNT;
+    for (int i = 0; i < 40 && report_ok; i++) {
+        KitchenReport before = report_kitchen.report();
+        const Dish& dish = mixed_generator.menu()[(i * 17) % 60];
+        if (i % 5 == 4) {
+            report_kitchen.serveDish(mixed_generator.menu()[(i * 17 - 17) % 60]);
+        } else {
+            report_kitchen.newOrder(dish);
+        }
+        const KitchenReport& after = report_kitchen.report();
+        std::vector<KitchenReportLine> changes = report_kitchen.reportChangesSince(before.version);
+        size_t differing = 0;
+        for (int line = 0; line < KitchenReport::LINE_COUNT; line++) {
+            differing += before.lines[line] != after.lines[line];
+        }
+        report_ok = after.version == report_kitchen.version() && after.version != before.version &&
+                    after.text == referenceReport(report_kitchen) && changes.size() == differing;
+        for (const KitchenReportLine& change : changes) {
+            report_ok = report_ok && change.text == after.lines[change.index] &&
+                        change.text != before.lines[change.index];
+        }
+    }
+    // A rejected order changes nothing, so the cached report is served as is
+    report_kitchen.newOrder(mixed_generator.menu()[0]);
+    uint64_t unchanged_version = report_kitchen.version();
+    const std::string* cached_text = &report_kitchen.report().text;
+    report_kitchen.newOrder(mixed_generator.menu()[0]);
+    report_ok = report_ok && report_kitchen.reportChangesSince(unchanged_version).empty() &&
+                &report_kitchen.report().text == cached_text && report_kitchen.version() == unchanged_version;
+    std::cout << "Changed since version 1:" << std::endl;
+    for (const KitchenReportLine& change : report_kitchen.reportChangesSince(1)) {
+        std::cout << "  " << change.text << std::endl;
+    }
+    // Several readers find the report stale at once; one rebuilds it and all see the same text
+    report_kitchen.serveDish(mixed_generator.menu()[0]);
+    std::string expected_text = referenceReport(report_kitchen);
+    std::atomic<int> stale_reads{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; t++) {
+        readers.emplace_back([&] {
+            bool current = report_kitchen.report().text == expected_text &&
+                           report_kitchen.reportChangesSince(unchanged_version).size() > 0;
+            stale_reads += !current;
+        });
+    }
+    for (std::thread& reader : readers) {
+        reader.join();
+    }
+    report_ok = report_ok && stale_reads == 0;
+    if (!report_ok) {
+        std::cout << "FAILED: the cached report or its changes are wrong" << std::endl;
+        return 1;
+    }
+
+    // Test: change events reach the subscribers of their types, coalesced per interval, and a full
+    // queue drops events without blocking the kitchen
+    std::cout << "\n---- Testing Kitchen Events ----" << std::endl;
+    KitchenEventQueue event_queue(1024);
+    KitchenEventDispatcher dispatcher(event_queue, std::chrono::milliseconds(3600 * 1000)); // Only flush() delivers
+    std::vector<KitchenEventSummary> all_batches, serve_batches;
+    dispatcher.subscribe(KitchenEventDispatcher::ALL_EVENTS,
+                         [&](const KitchenEventBatch& batch) { all_batches.push_back(batch.summary); });
+    dispatcher.subscribe(KitchenEventDispatcher::maskOf(KitchenEvent::DISH_SERVED),
+                         [&](const KitchenEventBatch& batch) { serve_batches.push_back(batch.summary); });
+    Kitchen event_kitchen;
+    event_kitchen.setEventQueue(&event_queue);
+    long long expected_added = 0, expected_served = 0, expected_released = 0;
+    for (int i = 0; i < 40; i++) {
+        expected_added += event_kitchen.newOrder(mixed_generator.menu()[i % 30]);
+    }
+    dispatcher.poll();
+    dispatcher.flush();
+    bool events_ok = all_batches.size() == 1 && serve_batches.empty() && all_batches[0].added == expected_added &&
+                     all_batches[0].last_version == event_kitchen.version();
+    for (int i = 0; i < 10; i++) {
+        expected_served += event_kitchen.serveDish(mixed_generator.menu()[i * 2]);
+    }
+    expected_released += event_kitchen.releaseDishesOfCuisineType("MEXICAN");
+    expected_added += event_kitchen.bulkLoad({mixed_generator.menu()[50], mixed_generator.menu()[51]}).added;
+    expected_released += event_kitchen.releaseDishesOfCuisineType("ALL");
+    dispatcher.flush();
+    dispatcher.flush(); // Nothing new: no one is called
+    long long summed_added = 0, summed_served = 0, summed_released = 0;
+    for (const KitchenEventSummary& summary : all_batches) {
+        summed_added += summary.added;
+        summed_served += summary.served;
+        summed_released += summary.released;
+    }
+    events_ok = events_ok && all_batches.size() == 2 && serve_batches.size() == 1 && summed_added == expected_added &&
+                summed_served == expected_served && summed_released == expected_released &&
+                serve_batches[0].served == expected_served && all_batches[1].dropped == 0;
+
+    // A full queue counts what it could not hold
+    KitchenEventQueue small_queue(8);
+    KitchenEventDispatcher small_dispatcher(small_queue, std::chrono::milliseconds(3600 * 1000));
+    KitchenEventSummary small_summary;
+    small_dispatcher.subscribe(KitchenEventDispatcher::ALL_EVENTS,
+                               [&](const KitchenEventBatch& batch) { small_summary = batch.summary; });
+    event_kitchen.setEventQueue(&small_queue);
+    for (int i = 0; i < 20; i++) {
+        event_kitchen.newOrder(mixed_generator.menu()[i]);
+    }
+    small_dispatcher.flush();
+    events_ok = events_ok && small_summary.event_count == 8 && small_summary.dropped == 12;
+
+    // On its own thread, the dispatcher delivers every event or counts it as dropped
+    event_kitchen.setEventQueue(&event_queue);
+    std::atomic<long long> delivered{0};
+    dispatcher.subscribe(KitchenEventDispatcher::ALL_EVENTS, [&](const KitchenEventBatch& batch) {
+        delivered += batch.summary.event_count + batch.summary.dropped;
+    });
+    dispatcher.start();
+    long long published = 0;
+    for (int i = 0; i < 20000; i++) {
+        const Dish& dish = mixed_generator.menu()[i % 70];
+        published += i % 2 == 0 ? event_kitchen.newOrder(dish) : event_kitchen.serveDish(mixed_generator.menu()[(i + 35) % 70]);
+    }
+    dispatcher.stop();
+    events_ok = events_ok && delivered == published;
+    event_kitchen.setEventQueue(nullptr);
+    std::cout << summed_added << " added, " << summed_served << " served, " << summed_released << " released; "
+              << published << " events from the threaded run" << std::endl;
+    if (!events_ok) {
+        std::cout << "FAILED: change events were lost or miscounted" << std::endl;
+        return 1;
+    }
+
+    // Test: undo and redo step every kind of change back and forth exactly, and the journal stays
+    // within its memory budget
+    std::cout << "\n---- Testing Undo Journal ----" << std::endl;
+    struct KitchenState {
+        std::vector<Dish> dishes;
+        int prep_time_sum;
+        int elaborate;
+        std::string report;
+    };
+    auto stateOf = [](const Kitchen& kitchen) {
+        return KitchenState{std::vector<Dish>(kitchen.begin(), kitchen.end()), kitchen.getPrepTimeSum(),
+                            kitchen.elaborateDishCount(), kitchen.report().text};
+    };
+    auto sameState = [](const Kitchen& kitchen, const KitchenState& state) {
+        bool same = std::equal(kitchen.begin(), kitchen.end(), state.dishes.begin(), state.dishes.end()) &&
+                    kitchen.getPrepTimeSum() == state.prep_time_sum &&
+                    kitchen.elaborateDishCount() == state.elaborate && kitchen.report().text == state.report;
+        for (const Dish& dish : state.dishes) {
+            same = same && kitchen.contains(dish); // The hot table is back in step too
+        }
+        return same;
+    };
+    Kitchen undo_kitchen, undo_other;
+    undo_kitchen.enableUndo();
+    std::vector<KitchenState> states = {stateOf(undo_kitchen)};
+    uint64_t recorded_version = undo_kitchen.version();
+    auto recordState = [&] {
+        // Only a change that did something becomes an undo entry
+        if (undo_kitchen.version() != recorded_version) {
+            states.push_back(stateOf(undo_kitchen));
+            recorded_version = undo_kitchen.version();
+        }
+    };
+    std::vector<KitchenCommand> undo_commands;
+    for (int i = 0; i < 30; i++) {
+        undo_commands.push_back({i % 3 == 2 ? KitchenCommand::SERVE_DISH : KitchenCommand::NEW_ORDER,
+                                 &mixed_generator.menu()[(i * 11) % 50]});
+    }
+    std::vector<bool> undo_results;
+    for (int round = 0; round < 2; round++) {
+        for (int i = 0; i < 25; i++) {
+            undo_kitchen.newOrder(mixed_generator.menu()[(i * 7 + round) % 60]);
+            recordState();
+        }
+        undo_kitchen.serveDish(mixed_generator.menu()[7]);
+        recordState();
+        undo_kitchen.releaseDishesBelowPrepTime(20);
+        recordState();
+        undo_kitchen.bulkLoad(std::vector<Dish>(mixed_generator.menu().begin() + 60, mixed_generator.menu().begin() + 90));
+        recordState();
+        undo_kitchen.applyBatch(undo_commands, undo_results);
+        recordState();
+        undo_kitchen.releaseWhere([](const Dish& dish) { return dish.getPrice() > 20; });
+        recordState();
+        undo_kitchen.partitionInto(undo_other, [](const Dish& dish) { return dish.getPrepTime() > 60; });
+        recordState();
+        undo_kitchen.releaseDishesOfCuisineType("ITALIAN");
+        recordState();
+        undo_kitchen.releaseDishesOfCuisineType("ALL");
+        recordState();
+        undo_kitchen.newOrder(mixed_generator.menu()[0]);
+        recordState();
+        undo_kitchen.newOrder(mixed_generator.menu()[0]); // A duplicate changes nothing
+        recordState();
+        undo_kitchen.clear();
+        recordState();
+    }
+    bool undo_ok = undo_kitchen.undoDepth() == states.size() - 1 && sameState(undo_kitchen, states.back());
+    size_t undone = 0;
+    for (size_t i = states.size() - 1; i > 0 && undo_ok; i--) {
+        undo_ok = undo_kitchen.undo() && sameState(undo_kitchen, states[i - 1]);
+        undone++;
+    }
+    undo_ok = undo_ok && !undo_kitchen.undo() && undo_kitchen.redoDepth() == undone;
+    for (size_t i = 1; i < states.size() && undo_ok; i++) {
+        undo_ok = undo_kitchen.redo() && sameState(undo_kitchen, states[i]);
+    }
+    undo_ok = undo_ok && !undo_kitchen.redo();
+
+    // A new change after an undo discards what could have been redone
+    undo_kitchen.undo();
+    undo_kitchen.newOrder(mixed_generator.menu()[99]);
+    undo_ok = undo_ok && undo_kitchen.redoDepth() == 0 && !undo_kitchen.redo();
+
+    // A small budget keeps only the newest changes
+    Kitchen budget_kitchen;
+    const size_t BUDGET = 4096;
+    budget_kitchen.enableUndo(BUDGET);
+    for (int i = 0; i < 100; i++) {
+        budget_kitchen.newOrder(mixed_generator.menu()[i]);
+        undo_ok = undo_ok && budget_kitchen.undoBytes() <= BUDGET;
+    }
+    size_t kept = budget_kitchen.undoDepth();
+    size_t kept_undone = 0;
+    while (budget_kitchen.undo()) {
+        kept_undone++;
+    }
+    undo_ok = undo_ok && kept > 0 && kept < 100 && kept_undone <= kept &&
+              budget_kitchen.getCurrentSize() == static_cast<int>(100 - kept_undone);
+    std::cout << "Stepped " << undone << " changes back and forward; a " << BUDGET << "-byte journal kept the last "
+              << kept << " of 100 orders" << std::endl;
+    if (!undo_ok) {
+        std::cout << "FAILED: undo or redo did not restore the kitchen exactly" << std::endl;
+        return 1;
+    }
+
+    // Test: workload files round-trip, and truncated or corrupt files are rejected before anything
+    // is sized from their header
+    std::cout << "\n---- Testing Workload Files ----" << std::endl;
+    const char* WORKLOAD_PATH = "test_workload.bin";
+    WorkloadGenerator file_generator{WorkloadConfig()};
+    WorkloadGenerator replay_generator{WorkloadConfig()};
+    std::vector<Operation> expected_ops = replay_generator.batch(1000);
+    std::vector<Operation> read_ops;
+    bool files_ok = file_generator.writeFile(WORKLOAD_PATH, 1000) &&
+                    WorkloadGenerator::readFile(WORKLOAD_PATH, read_ops) && read_ops.size() == expected_ops.size();
+    for (size_t i = 0; i < read_ops.size() && files_ok; i++) {
+        files_ok = read_ops[i].type == expected_ops[i].type && read_ops[i].arg == expected_ops[i].arg;
+    }
+    std::string file_bytes;
+    {
+        std::ifstream in(WORKLOAD_PATH, std::ios::binary);
+        file_bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    auto readsBack = [&](const std::string& bytes) {
+        std::ofstream(WORKLOAD_PATH, std::ios::binary | std::ios::trunc) << bytes;
+        std::vector<Operation> ops;
+        return WorkloadGenerator::readFile(WORKLOAD_PATH, ops);
+    };
+    const size_t COUNT_OFFSET = file_bytes.size() - 1000 * sizeof(Operation) - sizeof(uint64_t);
+    std::string truncated = file_bytes.substr(0, file_bytes.size() - 1);
+    std::string huge_count = file_bytes;
+    uint64_t claimed = uint64_t(1) << 40;
+    huge_count.replace(COUNT_OFFSET, sizeof(claimed), reinterpret_cast<const char*>(&claimed), sizeof(claimed));
+    std::string bad_type = file_bytes;
+    bad_type[COUNT_OFFSET + sizeof(uint64_t)] = 9; // The type of the first operation
+    files_ok = files_ok && readsBack(file_bytes) && !readsBack(truncated) && !readsBack(huge_count) &&
+               !readsBack(bad_type);
+    std::remove(WORKLOAD_PATH);
+    std::cout << "Read back " << read_ops.size() << " operations; rejected truncated, oversized and corrupt files"
+              << std::endl;
+    if (!files_ok) {
+        std::cout << "FAILED: a workload file was misread or a bad one was accepted" << std::endl;
+        return 1;
+    }
+
+    // Test: the latency timers count every call exactly while sampling only some, and time nothing
+    // once switched off
+    std::cout << "\n---- Testing Latency Sampling ----" << std::endl;
+    KitchenLatency::reset();
+    KitchenLatency::setSampleInterval(4);
+    Kitchen sampled_kitchen;
+    for (int i = 0; i < 40; i++) {
+        sampled_kitchen.serveDish(dish1); // Not in the kitchen; still a timed call
+    }
+    uint64_t sampled_calls = KitchenLatency::callCount(KitchenLatency::SERVE_DISH);
+    uint64_t estimated_calls = KitchenLatency::snapshot(KitchenLatency::SERVE_DISH).count();
+    KitchenLatency::setEnabled(false);
+    for (int i = 0; i < 40; i++) {
+        sampled_kitchen.serveDish(dish1);
+    }
+    KitchenLatency::setEnabled(true);
+    uint64_t disabled_calls = KitchenLatency::callCount(KitchenLatency::SERVE_DISH);
+    KitchenLatency::setSampleInterval(16);
+    std::cout << "Counted " << sampled_calls << " calls, estimated " << estimated_calls << " from samples; "
+              << disabled_calls - sampled_calls << " counted while off" << std::endl;
+    if (sampled_calls != 40 || estimated_calls + 4 <= 40 || estimated_calls > 40 || disabled_calls != sampled_calls) {
+        std::cout << "FAILED: latency calls were miscounted or timed while off" << std::endl;
+        return 1;
+    }
+
+    // Test: a thread's trace buffer is freed when the thread exits, unless it holds events still to
+    // be exported, which clear() then frees
+    std::cout << "\n---- Testing Trace Buffers ----" << std::endl;
+    Trace::clear();
+    size_t buffers_before = Trace::bufferCount();
+    Trace::setEnabled(true);
+    std::thread([] { TRACE_SCOPE("traced thread"); }).join();
+    size_t buffers_kept = Trace::bufferCount();
+    std::ostringstream trace_json;
+    Trace::writeJson(trace_json);
+    Trace::clear();
+    size_t buffers_cleared = Trace::bufferCount();
+    std::thread([] {
+        {
+            TRACE_SCOPE("cleared span");
+        }
+        Trace::clear(); // Leaves this thread's buffer empty when it exits
+    }).join();
+    size_t buffers_after = Trace::bufferCount();
+    Trace::setEnabled(false);
+    std::cout << "Buffers: " << buffers_before << " before, " << buffers_kept << " with an exited thread's events, "
+              << buffers_cleared << " after clear, " << buffers_after << " after an empty thread exited" << std::endl;
+    if (buffers_kept != buffers_before + 1 || trace_json.str().find("traced thread") == std::string::npos ||
+        buffers_cleared != buffers_before || buffers_after != buffers_before) {
+        std::cout << "FAILED: a trace buffer was leaked or freed before its events were exported" << std::endl;
+        return 1;
+    }
+
+    // Test: a disabled span does not evaluate its argument
+    int span_argument_evaluations = 0;
+    {
+        TRACE_SCOPE_N("disabled span", ++span_argument_evaluations);
+    }
+    if (span_argument_evaluations != 0) {
+        std::cout << "FAILED: a disabled TRACE_SCOPE_N evaluated its argument" << std::endl;
+        return 1;
+    }
+
+    // Test: writeJson leaves the caller's stream format as it found it
+    std::ostringstream formatted;
+    formatted << std::setprecision(5);
+    Trace::writeJson(formatted);
+    if (formatted.precision() != 5 || (formatted.flags() & std::ios_base::floatfield) != 0) {
+        std::cout << "FAILED: writeJson changed the caller's stream format" << std::endl;
+        return 1;
+    }
+
     return 0;
 }